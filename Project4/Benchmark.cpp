@@ -0,0 +1,347 @@
+// Benchmark.cpp
+#include "Benchmark.h"
+#include "Game.h"
+#include "Metrics.h"
+#include "MuteStdout.h"
+#include "StressTester.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const float FRAME_TIME = 1.0f / 60.0f;
+
+    //      ,  -  
+    bool higherIsBetter(const std::string& metric) {
+        const std::string suffix = "_per_second";
+        return metric.size() >= suffix.size() && metric.compare(metric.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    bool sameInput(const SessionInput& first, const SessionInput& second) {
+        return first.kind == second.kind && first.row == second.row && first.col == second.col
+            && first.doubleClick == second.doubleClick;
+    }
+
+    //      
+    double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        std::size_t middle = values.size() / 2;
+        return values.size() % 2 != 0 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+    }
+
+    //  SFML,  processEvents      (  ).
+    //        ,  Game     .
+    sf::Event makeEvent(const SessionInput& input, sf::Vector2i& lastClick) {
+        sf::Event event;
+        if (input.kind != SessionInput::Kind::Click) {
+            event.type = sf::Event::KeyPressed;
+            event.key.code = input.kind == SessionInput::Kind::Undo ? sf::Keyboard::Z : sf::Keyboard::Y;
+            event.key.control = true;
+            event.key.alt = false;
+            event.key.shift = false;
+            event.key.system = false;
+            return event;
+        }
+
+        sf::Vector2i position(input.col * TILE_SIZE + TILE_SIZE / 2, input.row * TILE_SIZE + TILE_SIZE / 2);
+        if (std::abs(position.x - lastClick.x) < TILE_SIZE / 4 && std::abs(position.y - lastClick.y) < TILE_SIZE / 4) {
+            position.x += TILE_SIZE / 4;
+        }
+        lastClick = position;
+
+        event.type = sf::Event::MouseButtonPressed;
+        event.mouseButton.button = sf::Mouse::Left;
+        event.mouseButton.x = position.x;
+        event.mouseButton.y = position.y;
+        return event;
+    }
+}
+
+Benchmark::Benchmark(const Options& options) : options(options) {}
+
+int Benchmark::run() {
+    std::vector<Session> sessions;
+    if (!loadCorpus(sessions)) {
+        return 2;
+    }
+
+    std::map<std::string, double> results;
+    if (!measure(sessions, results)) {
+        return 2;
+    }
+
+    if (options.updateBaseline) {
+        if (!saveBaseline(results)) {
+            return 2;
+        }
+        std::cout << "Baseline written to " << options.baseline << "\n";
+        for (const auto& [metric, value] : results) {
+            std::cout << "  " << std::left << std::setw(24) << metric << std::fixed << std::setprecision(0) << value << "\n";
+        }
+        return 0;
+    }
+
+    std::map<std::string, BaselineEntry> baseline;
+    if (!loadBaseline(baseline)) {
+        return 2;
+    }
+
+    bool regressed = false;
+    std::cout << std::left << std::setw(24) << "metric" << std::right << std::setw(14) << "baseline"
+        << std::setw(14) << "measured" << std::setw(10) << "change" << "\n";
+    for (const auto& [metric, value] : results) {
+        std::cout << std::left << std::setw(24) << metric << std::right << std::fixed << std::setprecision(0);
+        auto entry = baseline.find(metric);
+        if (entry == baseline.end()) {
+            //     ()     --update-baseline
+            std::cout << std::setw(14) << "-" << std::setw(14) << value << "  not gated\n";
+            continue;
+        }
+        if (!entry->second.gated) {
+            std::cout << std::setw(14) << entry->second.value << std::setw(14) << value << "  not gated\n";
+            continue;
+        }
+
+        double base = entry->second.value;
+        double change = base > 0 ? (value - base) / base : 0.0;
+        bool bad = higherIsBetter(metric) ? change < -entry->second.tolerance : change > entry->second.tolerance;
+        regressed = regressed || bad;
+        std::cout << std::setw(14) << base << std::setw(14) << value << std::setw(9) << std::showpos
+            << std::setprecision(1) << change * 100.0 << "%" << std::noshowpos
+            << (bad ? "  REGRESSION" : "") << "\n";
+    }
+
+    for (const auto& [metric, entry] : baseline) {
+        if (results.find(metric) == results.end()) {
+            std::cerr << "     : " << metric << "\n";
+            regressed = true;
+        }
+    }
+
+    std::cout << (regressed ? "Benchmark FAILED: performance regressed\n" : "Benchmark passed\n");
+    return regressed ? 1 : 0;
+}
+
+bool Benchmark::recordCorpus(const std::string& directory, int count, int steps) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "   : " << directory << "\n";
+        return false;
+    }
+    for (int seed = 1; seed <= count; ++seed) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "session_%03d.txt", seed);
+        Session session = StressTester(static_cast<unsigned int>(seed)).generate(steps);
+        if (!session.save(directory + "/" + name)) {
+            return false;
+        }
+    }
+    std::cout << "Recorded " << count << " sessions of " << steps << " actions to " << directory << "\n";
+    return true;
+}
+
+bool Benchmark::loadCorpus(std::vector<Session>& sessions) const {
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(options.corpus, error)) {
+        std::string name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.rfind("session_", 0) == 0) {
+            files.push_back(entry.path().string());
+        }
+    }
+    if (error || files.empty()) {
+        std::cerr << "     : " << options.corpus << "\n";
+        return false;
+    }
+
+    //     ,       
+    std::sort(files.begin(), files.end());
+    for (const auto& file : files) {
+        Session session;
+        if (!session.load(file)) {
+            std::cerr << "   : " << file << "\n";
+            return false;
+        }
+        sessions.push_back(std::move(session));
+    }
+    return true;
+}
+
+bool Benchmark::measure(const std::vector<Session>& sessions, std::map<std::string, double>& results) const {
+    sf::RenderTexture target;
+    if (!target.create(COLS * TILE_SIZE, ROWS * TILE_SIZE + 50)) {
+        std::cerr << "    \n";
+        return false;
+    }
+
+    MuteStdout mute;
+    using Clock = std::chrono::steady_clock;
+    auto elapsedNs = [](Clock::time_point start) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    };
+
+    //      ,      :
+    //  ,     ,   
+    std::map<std::string, std::vector<double>> passes;
+
+    //  0 -  (, , ),   
+    for (int pass = 0; pass <= options.repetitions; ++pass) {
+        Histogram inputLatency("bench_input_latency_ns", "", 34);
+        Histogram frameLatency("bench_frame_latency_ns", "", 34);
+        std::uint64_t inputs = 0;
+        std::uint64_t inputNs = 0;
+        std::uint64_t frameNs = 0;
+
+        for (const auto& session : sessions) {
+            Game game(session.seed, true);
+            game.beginSession(session.board, session.seed);
+            sf::Vector2i lastClick(-TILE_SIZE, -TILE_SIZE);
+
+            for (const auto& input : session.inputs) {
+                std::size_t recorded = game.getSession().inputs.size();
+
+                //       Game (0.3   ),
+                //     :       
+                bool direct = input.kind == SessionInput::Kind::Click && input.doubleClick;
+                sf::Event event = direct ? sf::Event() : makeEvent(input, lastClick);
+
+                auto start = Clock::now();
+                if (direct) {
+                    game.applyInput(input);
+                }
+                else {
+                    game.handleEvent(event);
+                }
+                std::uint64_t inputTime = elapsedNs(start);
+
+                start = Clock::now();
+                game.update(FRAME_TIME);
+                game.draw(target);
+                target.display();
+                std::uint64_t frameTime = elapsedNs(start);
+
+                //       ,      
+                const auto& actual = game.getSession().inputs;
+                if (actual.size() != recorded + 1 || !sameInput(actual.back(), input)) {
+                    std::cerr << " " << session.seed << "      " << recorded << "\n";
+                    return false;
+                }
+
+                inputLatency.record(inputTime);
+                frameLatency.record(frameTime);
+                inputNs += inputTime;
+                frameNs += frameTime;
+                ++inputs;
+            }
+        }
+
+        if (inputs == 0) {
+            std::cerr << "    \n";
+            return false;
+        }
+        if (pass == 0) {
+            continue;
+        }
+        passes["input_latency_p50_ns"].push_back(static_cast<double>(inputLatency.valueAtQuantile(0.5)));
+        passes["input_latency_p99_ns"].push_back(static_cast<double>(inputLatency.valueAtQuantile(0.99)));
+        passes["input_latency_p999_ns"].push_back(static_cast<double>(inputLatency.valueAtQuantile(0.999)));
+        passes["inputs_per_second"].push_back(inputNs > 0 ? inputs * 1e9 / inputNs : 0.0);
+        passes["frame_latency_p50_ns"].push_back(static_cast<double>(frameLatency.valueAtQuantile(0.5)));
+        passes["frame_latency_p99_ns"].push_back(static_cast<double>(frameLatency.valueAtQuantile(0.99)));
+        passes["frames_per_second"].push_back(frameNs > 0 ? inputs * 1e9 / frameNs : 0.0);
+    }
+
+    for (const auto& [metric, values] : passes) {
+        results[metric] = median(values);
+    }
+    return true;
+}
+
+bool Benchmark::loadBaseline(std::map<std::string, BaselineEntry>& baseline) const {
+    std::ifstream file(options.baseline);
+    if (!file) {
+        std::cerr << "    : " << options.baseline << " (   --update-baseline)\n";
+        return false;
+    }
+
+    //  : "  [ | ungated]", # - 
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream stream(line);
+        std::string metric;
+        std::string extra;
+        BaselineEntry entry{ 0.0, options.tolerance, true };
+        bool valid = static_cast<bool>(stream >> metric >> entry.value);
+        if (valid && stream >> extra) {
+            if (extra == "ungated") {
+                entry.gated = false;
+            }
+            else {
+                std::istringstream tolerance(extra);
+                valid = tolerance >> entry.tolerance && tolerance.eof();
+            }
+        }
+        if (!valid) {
+            std::cerr << "   : " << line << "\n";
+            return false;
+        }
+        baseline[metric] = entry;
+    }
+    return true;
+}
+
+bool Benchmark::saveBaseline(const std::map<std::string, double>& results) const {
+    // ,    ungated,  ,   
+    std::map<std::string, BaselineEntry> previous;
+    std::vector<std::string> comments;
+    {
+        std::ifstream existing(options.baseline);
+        if (existing) {
+            std::string line;
+            while (std::getline(existing, line)) {
+                if (!line.empty() && line[0] == '#') {
+                    comments.push_back(line);
+                }
+            }
+            if (!loadBaseline(previous)) {
+                return false;
+            }
+        }
+    }
+    if (comments.empty()) {
+        comments.push_back("# metric value [tolerance | ungated]");
+        comments.push_back("# Regenerate on the reference machine: Project4 --bench --update-baseline");
+    }
+
+    std::ofstream file(options.baseline);
+    if (!file) {
+        std::cerr << "   : " << options.baseline << "\n";
+        return false;
+    }
+    for (const auto& comment : comments) {
+        file << comment << "\n";
+    }
+    file << std::fixed << std::setprecision(0);
+    for (const auto& [metric, value] : results) {
+        file << metric << " " << value;
+        auto entry = previous.find(metric);
+        if (entry != previous.end() && !entry->second.gated) {
+            file << " ungated";
+        }
+        else if (entry != previous.end() && entry->second.tolerance != options.tolerance) {
+            file << " " << std::setprecision(2) << entry->second.tolerance << std::setprecision(0);
+        }
+        file << "\n";
+    }
+    return static_cast<bool>(file);
+}
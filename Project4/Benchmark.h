@@ -0,0 +1,47 @@
+// Benchmark.h
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Session.h"
+
+//  :      Game::handleEvent
+// (  processEvents;   -  applyInput),    
+//    .
+//     ;     .
+class Benchmark {
+public:
+    struct Options {
+        std::string corpus = "benchmarks";                   //    session_*.txt
+        std::string baseline = "benchmarks/baseline.txt";
+        double tolerance = 0.15;    //    (),       
+        int repetitions = 5;        //      (   )
+        bool updateBaseline = false;
+    };
+
+    explicit Benchmark(const Options& options);
+
+    // 0 -  , 1 - , 2 -  ( ,    ..)
+    int run();
+
+    //  : count   steps ,  1..count
+    static bool recordCorpus(const std::string& directory, int count, int steps);
+
+private:
+    struct BaselineEntry {
+        double value;
+        double tolerance;
+        bool gated;     // false -   "ungated": ,   
+    };
+
+    bool loadCorpus(std::vector<Session>& sessions) const;
+    bool measure(const std::vector<Session>& sessions, std::map<std::string, double>& results) const;
+    bool loadBaseline(std::map<std::string, BaselineEntry>& baseline) const;
+    bool saveBaseline(const std::map<std::string, double>& results) const;
+
+    Options options;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,160 @@
+// BoardGenerator.cpp
+#include "BoardGenerator.h"
+
+void BoardGenerator::generate(std::mt19937& rng, ColorGrid& out) {
+    //     6    ,    
+    do {
+        fill(rng, out);
+    } while (!hasValidMove(out));
+}
+
+void BoardGenerator::fill(std::mt19937& rng, ColorGrid& out) {
+    //  ,     (      2)
+    std::array<std::array<int, COLS>, ROWS> clusterSize;
+
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            int upColor = row > 0 ? out[row - 1][col] : -1;
+            int leftColor = col > 0 ? out[row][col - 1] : -1;
+
+            //  ,         2
+            int allowed[NUM_COLORS];
+            int allowedCount = 0;
+            for (int color = 0; color < NUM_COLORS; ++color) {
+                int size = 1;
+                if (color == upColor) size += clusterSize[row - 1][col];
+                if (color == leftColor) size += clusterSize[row][col - 1];
+                if (size <= 2) {
+                    allowed[allowedCount++] = color;
+                }
+            }
+
+            std::uniform_int_distribution<int> dist(0, allowedCount - 1);
+            int color = allowed[dist(rng)];
+            out[row][col] = color;
+            clusterSize[row][col] = 1;
+
+            //   -  
+            if (color == upColor) {
+                clusterSize[row][col] = clusterSize[row - 1][col] = 2;
+            }
+            else if (color == leftColor) {
+                clusterSize[row][col] = clusterSize[row][col - 1] = 2;
+            }
+        }
+    }
+}
+
+bool BoardGenerator::clusterAtLeast(const ColorGrid& grid, int row, int col, int limit) {
+    //   ,     limit 
+    int color = grid[row][col];
+    std::array<std::pair<int, int>, ROWS * COLS> stack;
+    std::array<std::array<bool, COLS>, ROWS> visited{};
+    int top = 0;
+    int count = 1;
+    stack[top++] = { row, col };
+    visited[row][col] = true;
+
+    const int dr[] = { -1, 1, 0, 0 };
+    const int dc[] = { 0, 0, -1, 1 };
+    while (top > 0) {
+        auto [r, c] = stack[--top];
+        for (int dir = 0; dir < 4; ++dir) {
+            int nr = r + dr[dir];
+            int nc = c + dc[dir];
+            if (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS && !visited[nr][nc] && grid[nr][nc] == color) {
+                if (++count >= limit) {
+                    return true;
+                }
+                visited[nr][nc] = true;
+                stack[top++] = { nr, nc };
+            }
+        }
+    }
+    return count >= limit;
+}
+
+bool BoardGenerator::hasMatches(const ColorGrid& grid) {
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            if (clusterAtLeast(grid, row, col, 3)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool BoardGenerator::hasValidMove(const ColorGrid& grid) {
+    ColorGrid board = grid;
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            //      
+            const int targets[2][2] = { { row, col + 1 }, { row + 1, col } };
+            for (auto& target : targets) {
+                int otherRow = target[0];
+                int otherCol = target[1];
+                if (otherRow >= ROWS || otherCol >= COLS || board[row][col] == board[otherRow][otherCol]) {
+                    continue;
+                }
+                std::swap(board[row][col], board[otherRow][otherCol]);
+                bool matched = clusterAtLeast(board, row, col, 3) || clusterAtLeast(board, otherRow, otherCol, 3);
+                std::swap(board[row][col], board[otherRow][otherCol]);
+                if (matched) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+BoardPool::BoardPool(std::size_t capacity, unsigned int seed)
+    : capacity(capacity),
+    running(true),
+    takeRng(seed),
+    workerRng(seed ^ 0x9E3779B9u),
+    worker(&BoardPool::work, this)
+{
+}
+
+BoardPool::~BoardPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    needMore.notify_all();
+    worker.join();
+}
+
+ColorGrid BoardPool::take() {
+    ColorGrid board;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!boards.empty()) {
+            board = boards.front();
+            boards.pop_front();
+            needMore.notify_one();
+            return board;
+        }
+    }
+    //     
+    BoardGenerator::generate(takeRng, board);
+    return board;
+}
+
+void BoardPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        if (boards.size() >= capacity) {
+            needMore.wait(lock, [this]() { return !running || boards.size() < capacity; });
+            continue;
+        }
+        //   ,  take()  
+        lock.unlock();
+        ColorGrid board;
+        BoardGenerator::generate(workerRng, board);
+        lock.lock();
+        boards.push_back(board);
+    }
+}
@@ -0,0 +1,61 @@
+// BoardGenerator.h
+#ifndef BOARDGENERATOR_H
+#define BOARDGENERATOR_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include "Constants.h"
+
+//    
+using ColorGrid = std::array<std::array<int, COLS>, ROWS>;
+
+//           
+class BoardGenerator {
+public:
+    //         (  ),
+    //        
+    static void generate(std::mt19937& rng, ColorGrid& out);
+
+    //       3     
+    static bool hasMatches(const ColorGrid& grid);
+
+    //     ,  
+    static bool hasValidMove(const ColorGrid& grid);
+
+private:
+    static void fill(std::mt19937& rng, ColorGrid& out);
+    static bool clusterAtLeast(const ColorGrid& grid, int row, int col, int limit);
+};
+
+//    ,   
+class BoardPool {
+public:
+    BoardPool(std::size_t capacity, unsigned int seed);
+    ~BoardPool();
+
+    BoardPool(const BoardPool&) = delete;
+    BoardPool& operator=(const BoardPool&) = delete;
+
+    //   ;   ,   
+    ColorGrid take();
+
+private:
+    void work();
+
+    std::size_t capacity;
+    std::deque<ColorGrid> boards;
+    std::mutex mutex;
+    std::condition_variable needMore;
+    bool running;
+    std::mt19937 takeRng; //    ,   
+    std::mt19937 workerRng;
+    std::thread worker;
+};
+
+#endif // BOARDGENERATOR_H
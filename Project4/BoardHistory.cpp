@@ -0,0 +1,44 @@
+// BoardHistory.cpp
+#include "BoardHistory.h"
+
+BoardSnapshot::BoardSnapshot() : score(0) {
+    Column empty;
+    empty.fill({ -1, BonusType::None });
+    //    
+    auto shared = std::make_shared<Column>(empty);
+    columns.fill(shared);
+}
+
+void BoardSnapshot::setColumn(int col, const Column& column) {
+    if (*columns[col] == column) {
+        return;
+    }
+    columns[col] = std::make_shared<Column>(column);
+}
+
+void BoardHistory::push(const BoardSnapshot& snapshot) {
+    entries.resize(position);
+    entries.push_back(snapshot);
+    position = entries.size();
+}
+
+void BoardHistory::clear() {
+    entries.clear();
+    position = 0;
+}
+
+const BoardSnapshot* BoardHistory::undo() {
+    if (!canUndo()) {
+        return nullptr;
+    }
+    --position;
+    return &entries[position - 1];
+}
+
+const BoardSnapshot* BoardHistory::redo() {
+    if (!canRedo()) {
+        return nullptr;
+    }
+    ++position;
+    return &entries[position - 1];
+}
@@ -0,0 +1,68 @@
+// BoardHistory.h
+#ifndef BOARDHISTORY_H
+#define BOARDHISTORY_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Constants.h"
+
+//    ( )
+struct CellState {
+    int color;
+    BonusType bonus;
+
+    bool operator==(const CellState& other) const { return color == other.color && bonus == other.bonus; }
+    bool operator!=(const CellState& other) const { return !(*this == other); }
+};
+
+//        (copy-on-write).
+//   -  COLS ;      .
+class BoardSnapshot {
+public:
+    using Column = std::array<CellState, ROWS>;
+
+    BoardSnapshot();
+
+    const CellState& at(int row, int col) const { return (*columns[col])[row]; }
+    const Column& getColumn(int col) const { return *columns[col]; }
+
+    //    ( ,    )
+    void setColumn(int col, const Column& column);
+
+    //            
+    bool sharesColumn(const BoardSnapshot& other, int col) const { return columns[col] == other.columns[col]; }
+
+    int score;
+
+private:
+    std::array<std::shared_ptr<Column>, COLS> columns;
+};
+
+//     undo/redo
+class BoardHistory {
+public:
+    BoardHistory() : position(0) {}
+
+    //     redo
+    void push(const BoardSnapshot& snapshot);
+    void clear();
+
+    bool canUndo() const { return position > 1; }
+    bool canRedo() const { return position < entries.size(); }
+
+    //     O(1);  ,   
+    const BoardSnapshot* undo();
+    const BoardSnapshot* redo();
+
+    bool empty() const { return position == 0; }
+    const BoardSnapshot& current() const { return entries[position - 1]; }
+    std::size_t size() const { return entries.size(); }
+
+private:
+    std::vector<BoardSnapshot> entries;
+    std::size_t position; //   ;  - entries[position - 1]
+};
+
+#endif // BOARDHISTORY_H
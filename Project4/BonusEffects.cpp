@@ -0,0 +1,143 @@
+// BonusEffects.cpp
+#include "BonusEffects.h"
+#include <algorithm>
+
+bool CellMask::insert(int row, int col) {
+    if (contains(row, col)) {
+        return false;
+    }
+    bits.set(row * COLS + col);
+    cells.emplace_back(row, col);
+    return true;
+}
+
+void CellMask::clear() {
+    //    ,    
+    for (auto& [row, col] : cells) {
+        bits.reset(row * COLS + col);
+    }
+    cells.clear();
+}
+
+void sampleCells(int rowMin, int rowMax, int colMin, int colMax, int skipRow, int skipCol,
+    int k, std::mt19937& rng, CellMask& out) {
+    int width = colMax - colMin + 1;
+    int area = (rowMax - rowMin + 1) * width;
+    bool skipInside = skipRow >= rowMin && skipRow <= rowMax && skipCol >= colMin && skipCol <= colMax;
+    int skipIndex = skipInside ? (skipRow - rowMin) * width + (skipCol - colMin) : area;
+    int n = skipInside ? area - 1 : area;
+    k = std::min(k, n);
+
+    //   [0, n) ->     (skipRow, skipCol)
+    auto cellAt = [&](int index) {
+        if (index >= skipIndex) {
+            ++index;
+        }
+        return std::make_pair(rowMin + index / width, colMin + index % width);
+    };
+
+    //  :       
+    for (int j = n - k; j < n; ++j) {
+        std::uniform_int_distribution<int> dist(0, j);
+        auto [r, c] = cellAt(dist(rng));
+        if (!out.insert(r, c)) {
+            auto [jr, jc] = cellAt(j);
+            out.insert(jr, jc);
+        }
+    }
+}
+
+int clearMaskCells(BonusBoard& board, const CellMask& mask, int, int) {
+    int affected = 0;
+    for (auto& [r, c] : mask.getCells()) {
+        if (board.cellAt(r, c).color < 0) {
+            continue;
+        }
+        board.clearBonus(r, c);
+        board.clearCell(r, c);
+        ++affected;
+    }
+    return affected;
+}
+
+int recolorMaskCells(BonusBoard& board, const CellMask& mask, int row, int col) {
+    int color = board.cellAt(row, col).color;
+    int affected = 0;
+    for (auto& [r, c] : mask.getCells()) {
+        //      :     
+        if (board.cellAt(r, c).color < 0) {
+            continue;
+        }
+        board.clearBonus(r, c);
+        board.recolorCell(r, c, color);
+        ++affected;
+    }
+    return affected;
+}
+
+int applyBonusEffect(const BonusEffect& effect, BonusBoard& board, const CellMask& mask, int row, int col) {
+    int affected = effect.apply(board, mask, row, col);
+    board.clearBonus(row, col);
+    //     
+    return effect.scorePerCell * affected;
+}
+
+namespace {
+    // : 2     3 (     )
+    void recolorKernel(const BonusBoard&, int row, int col, std::mt19937& rng, CellMask& out) {
+        sampleCells(std::max(0, row - 3), std::min(ROWS - 1, row + 3),
+            std::max(0, col - 3), std::min(COLS - 1, col + 3), row, col, 2, rng, out);
+    }
+
+    // :    4     
+    void bombKernel(const BonusBoard&, int row, int col, std::mt19937& rng, CellMask& out) {
+        out.insert(row, col);
+        sampleCells(0, ROWS - 1, 0, COLS - 1, row, col, 4, rng, out);
+    }
+}
+
+BonusRegistry& BonusRegistry::getInstance() {
+    static BonusRegistry instance;
+    return instance;
+}
+
+BonusRegistry::BonusRegistry() {
+    registerBonus({ BonusType::Recolor, "Recolor", recolorKernel, recolorMaskCells, 5,
+        sf::Color::Cyan, sf::Color::White, false, "recolor_sound", "recolor_activation.wav", "recolor_icon", "recolor_icon.png" });
+    registerBonus({ BonusType::Bomb, "Bomb", bombKernel, clearMaskCells, 20,
+        sf::Color::Red, sf::Color::Red, true, "bomb_sound", "bomb_activation.wav", "", "" });
+}
+
+void BonusRegistry::registerBonus(const BonusEffect& effect, bool canSpawn) {
+    auto it = std::find_if(effects.begin(), effects.end(),
+        [&](const BonusEffect& e) { return e.type == effect.type; });
+    if (it != effects.end()) {
+        *it = effect;
+    }
+    else {
+        effects.push_back(effect);
+    }
+
+    spawnable.erase(std::remove(spawnable.begin(), spawnable.end(), effect.type), spawnable.end());
+    if (canSpawn) {
+        spawnable.push_back(effect.type);
+    }
+}
+
+const BonusEffect* BonusRegistry::find(BonusType type) const {
+    //   ,    
+    for (const auto& effect : effects) {
+        if (effect.type == type) {
+            return &effect;
+        }
+    }
+    return nullptr;
+}
+
+BonusType BonusRegistry::pickSpawnable(std::mt19937& rng) const {
+    if (spawnable.empty()) {
+        return BonusType::None;
+    }
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(spawnable.size()) - 1);
+    return spawnable[dist(rng)];
+}
@@ -0,0 +1,100 @@
+// BonusEffects.h
+#ifndef BONUSEFFECTS_H
+#define BONUSEFFECTS_H
+
+#include <SFML/Graphics.hpp>
+#include <bitset>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Constants.h"
+#include "BoardHistory.h"
+
+//   : O(1)    O(k) /
+class CellMask {
+public:
+    bool contains(int row, int col) const { return bits.test(row * COLS + col); }
+    bool insert(int row, int col);
+    void clear();
+
+    bool empty() const { return cells.empty(); }
+    std::size_t size() const { return cells.size(); }
+    const std::vector<std::pair<int, int>>& getCells() const { return cells; }
+
+private:
+    std::bitset<ROWS * COLS> bits;
+    std::vector<std::pair<int, int>> cells;
+};
+
+//    . Game  MoveEvaluator     
+//  ,          
+class BonusBoard {
+public:
+    virtual ~BonusBoard() = default;
+
+    virtual CellState cellAt(int row, int col) const = 0;
+    virtual void clearCell(int row, int col) = 0;              //  
+    virtual void recolorCell(int row, int col, int color) = 0;
+    virtual void clearBonus(int row, int col) = 0;             //  ,   
+};
+
+//  :   ( )   ,      (row, col)
+using BonusKernel = void (*)(const BonusBoard& board, int row, int col, std::mt19937& rng, CellMask& out);
+
+//     ;     (   )
+using BonusApply = int (*)(BonusBoard& board, const CellMask& mask, int row, int col);
+
+//  :   (   ) ,
+//        
+int clearMaskCells(BonusBoard& board, const CellMask& mask, int row, int col);
+int recolorMaskCells(BonusBoard& board, const CellMask& mask, int row, int col); //    
+
+//   
+struct BonusEffect {
+    BonusType type;
+    std::string name;
+    BonusKernel kernel;
+    BonusApply apply;
+    int scorePerCell;
+    sf::Color highlightColor;
+    sf::Color animationColor;
+    bool showFuse;           //    
+    std::string soundName;   //    ResourceManager
+    std::string soundFile;
+    std::string iconTexture; //     ResourceManager (,   )
+    std::string iconFile;
+};
+
+//  :        (row, col).    
+int applyBonusEffect(const BonusEffect& effect, BonusBoard& board, const CellMask& mask, int row, int col);
+
+//   
+class BonusRegistry {
+public:
+    static BonusRegistry& getInstance();
+
+    BonusRegistry(const BonusRegistry&) = delete;
+    BonusRegistry& operator=(const BonusRegistry&) = delete;
+
+    //  ( ) ; canSpawn -      
+    void registerBonus(const BonusEffect& effect, bool canSpawn = true);
+    const BonusEffect* find(BonusType type) const;
+    const std::vector<BonusEffect>& getEffects() const { return effects; }
+
+    //    ,     
+    BonusType pickSpawnable(std::mt19937& rng) const;
+
+private:
+    BonusRegistry(); //   
+
+    std::vector<BonusEffect> effects;
+    std::vector<BonusType> spawnable;
+};
+
+//  k    [rowMin..rowMax] x [colMin..colMax]   (skipRow, skipCol)
+//  : O(k)     
+void sampleCells(int rowMin, int rowMax, int colMin, int colMax, int skipRow, int skipCol,
+    int k, std::mt19937& rng, CellMask& out);
+
+#endif // BONUSEFFECTS_H
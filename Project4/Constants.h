@@ -18,6 +18,24 @@ const float BONUS_CHANCE = 0.05f;
 //      ,    
 const int MAX_MATCH_CHECKS = 10;
 
+//         (   )
+const float CASCADE_STEP_TIME = 0.12f;
+const float BONUS_STEP_TIME = 0.25f;
+
+//       
+const int BOARD_POOL_SIZE = 8;
+
+//  :        
+const int HINT_SEARCH_DEPTH = 2;
+const int TRANSPOSITION_TABLE_SIZE = 1 << 16;
+
+// ,      
+const char* const SESSION_FILE = "last_session.txt";
+
+//      Prometheus     ( )
+const char* const METRICS_FILE = "gems_metrics.prom";
+const float METRICS_EXPORT_INTERVAL = 5.0f;
+
 //  
 enum class BonusType {
     None,
@@ -25,4 +43,7 @@ enum class BonusType {
     Bomb
 };
 
+//      ( ,  BonusType)
+const int MAX_BONUS_TYPES = 8;
+
 #endif // CONSTANTS_H
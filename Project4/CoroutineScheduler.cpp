@@ -0,0 +1,48 @@
+// CoroutineScheduler.cpp
+#include "CoroutineScheduler.h"
+
+void CoroutineScheduler::start(Task task) {
+    if (!task.handle) {
+        return;
+    }
+    auto entry = std::make_unique<Entry>();
+    entry->task = std::move(task);
+    entry->root.top = entry->task.handle;
+    entry->root.current = entry->task.handle;
+    entry->task.handle.promise().root = &entry->root;
+
+    if (!step(*entry)) {
+        tasks.push_back(std::move(entry));
+    }
+}
+
+void CoroutineScheduler::update(float deltaTime) {
+    for (std::size_t i = 0; i < tasks.size();) {
+        Entry& entry = *tasks[i];
+        entry.root.wait -= deltaTime;
+        if (entry.root.wait <= 0.0f && step(entry)) {
+            tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        ++i;
+    }
+}
+
+void CoroutineScheduler::runAll() {
+    while (!tasks.empty()) {
+        if (step(*tasks.front())) {
+            tasks.erase(tasks.begin());
+        }
+    }
+}
+
+void CoroutineScheduler::clear() {
+    //      :  Task    
+    tasks.clear();
+}
+
+bool CoroutineScheduler::step(Entry& entry) {
+    entry.root.wait = 0.0f;
+    entry.root.current.resume();
+    return entry.root.top.done();
+}
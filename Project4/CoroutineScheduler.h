@@ -0,0 +1,136 @@
+// CoroutineScheduler.h
+#ifndef COROUTINESCHEDULER_H
+#define COROUTINESCHEDULER_H
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class CoroutineScheduler;
+
+//    (, ).    
+// co_await   ;      .
+class Task {
+public:
+    struct Root;
+
+    struct promise_type {
+        std::coroutine_handle<> continuation;
+        Root* root = nullptr;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        //        (  )
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                std::coroutine_handle<> next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    //   :        
+    struct Root {
+        std::coroutine_handle<promise_type> top;
+        std::coroutine_handle<promise_type> current;
+        float wait = 0.0f;
+    };
+
+    Task() = default;
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ~Task() { reset(); }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    // co_await  :      
+    bool await_ready() const noexcept { return !handle || handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> parent) noexcept {
+        handle.promise().continuation = parent;
+        handle.promise().root = parent.promise().root;
+        return handle;
+    }
+    void await_resume() const noexcept {}
+
+private:
+    friend class CoroutineScheduler;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    void reset() {
+        if (handle) {
+            handle.destroy();
+            handle = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+//    seconds  ; 0 -   
+struct WaitFor {
+    float seconds;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<Task::promise_type> handle) const noexcept {
+        Task::Root* root = handle.promise().root;
+        root->current = handle;
+        root->wait = seconds;
+    }
+    void await_resume() const noexcept {}
+};
+
+//   :          ,
+//           
+class CoroutineScheduler {
+public:
+    CoroutineScheduler() = default;
+    ~CoroutineScheduler() { clear(); }
+
+    CoroutineScheduler(const CoroutineScheduler&) = delete;
+    CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+    //  :    ,   
+    void start(Task task);
+
+    //  : ,    ,    
+    void update(float deltaTime);
+
+    //        ( ,  )
+    void runAll();
+
+    //    ( )
+    void clear();
+
+    bool idle() const { return tasks.empty(); }
+
+private:
+    struct Entry {
+        Task task;
+        Task::Root root;
+    };
+
+    //  true,   
+    static bool step(Entry& entry);
+
+    //  Root  ,    
+    std::vector<std::unique_ptr<Entry>> tasks;
+};
+
+#endif // COROUTINESCHEDULER_H
@@ -4,13 +4,19 @@
 #include <algorithm>
 #include <cmath>
 #include <stack>
+#include <thread>
 
 Game::Game()
-    : window(sf::VideoMode(COLS * TILE_SIZE, ROWS * TILE_SIZE + 50), "GEMS"),
-    firstSelected(false),
+    : Game(std::random_device{}(), false)
+{
+}
+
+Game::Game(unsigned int seed, bool headless)
+    : firstSelected(false),
     selectedRow(-1),
     selectedCol(-1),
-    rng(std::random_device{}()),
+    rng(seed),
+    transpositionTable(TRANSPOSITION_TABLE_SIZE),
     colors({
         sf::Color::Red,
         sf::Color::Green,
@@ -19,22 +25,29 @@ Game::Game()
         sf::Color::Magenta,
         sf::Color(255, 165, 0) //    
         }),
-    score(0)
+    score(0),
+    instantCascades(headless),
+    liveData()
 {
+    //       handleClick (-)
+    if (!headless) {
+        window.create(sf::VideoMode(COLS * TILE_SIZE, ROWS * TILE_SIZE + 50), "GEMS");
+        boardPool = std::make_unique<BoardPool>(BOARD_POOL_SIZE, seed);
+    }
+
     //    ResourceManager
     ResourceManager& rm = ResourceManager::getInstance();
 
-    //    Recolor  ( )
-    if (rm.loadTexture("recolor_icon", "recolor_icon.png")) {
-     //   
-     }
-
-    //  
-    if (rm.loadSoundBuffer("bomb_sound", "bomb_activation.wav")) {
-        bombSound.setBuffer(rm.getSoundBuffer("bomb_sound"));
-    }
-    if (rm.loadSoundBuffer("recolor_sound", "recolor_activation.wav")) {
-        recolorSound.setBuffer(rm.getSoundBuffer("recolor_sound"));
+    //        .
+    //    :   (-, , )   ,
+    //  applyBonus         
+    for (const auto& effect : BonusRegistry::getInstance().getEffects()) {
+        if (!headless && !effect.soundName.empty() && rm.loadSoundBuffer(effect.soundName, effect.soundFile)) {
+            bonusSounds[effect.type].setBuffer(rm.getSoundBuffer(effect.soundName));
+        }
+        if (!effect.iconTexture.empty()) {
+            rm.loadTexture(effect.iconTexture, effect.iconFile);
+        }
     }
 
     //  
@@ -49,26 +62,140 @@ Game::Game()
     scoreText.setPosition(10.0f, ROWS * TILE_SIZE + 10.0f);
     scoreText.setString("Score: 0");
 
-    initializeGrid();
+    initializeGrid(seed);
 }
 
-void Game::initializeGrid() {
+void Game::initializeGrid(unsigned int seed) {
     grid.resize(ROWS, std::vector<Tile>(COLS));
 
-    //    
-    std::uniform_int_distribution<int> dist(0, NUM_COLORS - 1);
+    //           
+    ColorGrid board;
+    BoardGenerator::generate(rng, board);
+    beginSession(board, seed);
+}
+
+void Game::beginSession(const ColorGrid& board, unsigned int seed) {
+    //  ,     (board, seed)   
+    rng.seed(seed);
+    scheduler.clear();
+    pendingInputs.clear();
+    moveStats = MoveStats();
+    loadBoard(board);
+    activeAnimations.clear();
+    score = 0;
+    scoreText.setString("Score: 0");
+
+    history.clear();
+    history.push(captureSnapshot());
+
+    session.seed = seed;
+    session.board = board;
+    session.inputs.clear();
+}
+
+void Game::applyInput(const SessionInput& input) {
+    //  ,        :
+    //       ,   
+    session.inputs.push_back(input);
+    switch (input.kind) {
+    case SessionInput::Kind::Click:
+        handleClick(input.row, input.col, input.doubleClick);
+        break;
+    case SessionInput::Kind::Undo:
+        undo();
+        break;
+    case SessionInput::Kind::Redo:
+        redo();
+        break;
+    }
+}
+
+BoardSnapshot Game::captureSnapshot() const {
+    //     :    
+    BoardSnapshot snapshot = history.empty() ? BoardSnapshot() : history.current();
+    BoardSnapshot::Column column;
+    for (int col = 0; col < COLS; ++col) {
+        for (int row = 0; row < ROWS; ++row) {
+            column[row] = { grid[row][col].color, grid[row][col].bonus };
+        }
+        snapshot.setColumn(col, column);
+    }
+    snapshot.score = score;
+    return snapshot;
+}
+
+void Game::restoreSnapshot(const BoardSnapshot& snapshot) {
+    BonusRegistry& registry = BonusRegistry::getInstance();
     for (int row = 0; row < ROWS; ++row) {
         for (int col = 0; col < COLS; ++col) {
-            grid[row][col].color = dist(rng);
+            const CellState& cell = snapshot.at(row, col);
+            grid[row][col].color = cell.color;
+            grid[row][col].shape.setFillColor(cell.color >= 0 ? colors[cell.color] : sf::Color::Black);
+            grid[row][col].isSelected = false;
+            grid[row][col].resetFuse();
+
+            const BonusEffect* effect = registry.find(cell.bonus);
+            if (effect != nullptr) {
+                assignBonus(row, col, *effect);
+            }
+            else {
+                clearBonus(row, col);
+            }
+        }
+    }
+    firstSelected = false;
+    score = snapshot.score;
+    scoreText.setString("Score: " + std::to_string(score));
+}
+
+void Game::dispatchInput(const SessionInput& input) {
+    switch (input.kind) {
+    case SessionInput::Kind::Click:
+        clickTile(input.row, input.col, input.doubleClick);
+        break;
+    case SessionInput::Kind::Undo:
+        restoreFromHistory(history.undo());
+        break;
+    case SessionInput::Kind::Redo:
+        restoreFromHistory(history.redo());
+        break;
+    }
+}
+
+bool Game::undo() {
+    if (!isSettled()) {
+        pendingInputs.push_back(SessionInput::undo());
+        return false;
+    }
+    return restoreFromHistory(history.undo());
+}
+
+bool Game::redo() {
+    if (!isSettled()) {
+        pendingInputs.push_back(SessionInput::redo());
+        return false;
+    }
+    return restoreFromHistory(history.redo());
+}
+
+bool Game::restoreFromHistory(const BoardSnapshot* snapshot) {
+    if (snapshot == nullptr) {
+        return false;
+    }
+    restoreSnapshot(*snapshot);
+    return true;
+}
+
+void Game::loadBoard(const ColorGrid& board) {
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            grid[row][col].color = board[row][col];
             grid[row][col].shape.setFillColor(colors[grid[row][col].color]);
             grid[row][col].shape.setPosition(static_cast<float>(col * TILE_SIZE + 1), static_cast<float>(row * TILE_SIZE + 1));
             grid[row][col].bonus = BonusType::None; // ,    
             grid[row][col].isSelected = false;
             grid[row][col].resetFuse();
 
-            //   
-            grid[row][col].recolorIcon.setPosition(-100, -100);
-
             //  highlight
             grid[row][col].highlight.setOutlineColor(sf::Color::Transparent);
 
@@ -76,123 +203,216 @@ void Game::initializeGrid() {
             grid[row][col].animationOverlay.setFillColor(sf::Color::Transparent);
         }
     }
-
-    //      
-    std::vector<std::pair<int, int>> initialMatches;
-    int matchChecks = 0;
-    while (checkMatches(initialMatches) && matchChecks < MAX_MATCH_CHECKS) {
-        removeMatches(initialMatches, false); //  false,    
-        applyGravity();
-        initialMatches.clear(); //     
-        matchChecks++;
-    }
+    firstSelected = false;
 }
 
 void Game::run() {
+    metricsExporter.start(METRICS_FILE, METRICS_EXPORT_INTERVAL);
+    liveState.open();
     while (window.isOpen()) {
         float deltaTime = clock.restart().asSeconds();
+        auto workStart = std::chrono::steady_clock::now();
         processEvents();
-        update();
+        update(deltaTime);
         render();
+        publishLiveState(deltaTime, std::chrono::steady_clock::now() - workStart);
+    }
+    liveState.close();
+    metricsExporter.stop();
+
+    //         
+    session.save(SESSION_FILE);
+}
+
+void Game::publishLiveState(float deltaTime, std::chrono::steady_clock::duration workTime) {
+    static_assert(ROWS * COLS <= LIVE_STATE_MAX_CELLS, "      ");
+    if (!liveState.isOpen()) {
+        return;
+    }
+
+    liveData.rows = ROWS;
+    liveData.cols = COLS;
+    liveData.score = score;
+    liveData.settled = isSettled() ? 1 : 0;
+    liveData.frame++;
+    liveData.frameTimeNs = static_cast<std::uint64_t>(deltaTime * 1e9);
+    liveData.workTimeNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(workTime).count());
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            liveData.colors[row * COLS + col] = static_cast<std::int8_t>(grid[row][col].color);
+            liveData.bonuses[row * COLS + col] = static_cast<std::uint8_t>(grid[row][col].bonus);
+        }
     }
+    liveState.publish(liveData);
 }
 
 void Game::processEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
+        handleEvent(event);
+    }
+}
+
+void Game::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    // R -      
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::R && boardPool) {
+        beginSession(boardPool->take(), std::random_device{}());
+    }
+    // H -   
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H) {
+        showHint();
+    }
+    // Ctrl+Z / Ctrl+Y -    
+    if (event.type == sf::Event::KeyPressed && event.key.control) {
+        if (event.key.code == sf::Keyboard::Z) {
+            applyInput(SessionInput::undo());
         }
-        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-            sf::Vector2i clickPos(event.mouseButton.x, event.mouseButton.y);
-            float elapsed = clickClock.getElapsedTime().asSeconds();
-            bool isDoubleClick = false;
-
-            // ,     
-            if (elapsed < DOUBLE_CLICK_TIME) {
-                float distance = std::sqrt(std::pow(static_cast<float>(clickPos.x - lastClickPos.x), 2) + std::pow(static_cast<float>(clickPos.y - lastClickPos.y), 2));
-                if (distance < DOUBLE_CLICK_DISTANCE) {
-                    isDoubleClick = true;
-                }
+        else if (event.key.code == sf::Keyboard::Y) {
+            applyInput(SessionInput::redo());
+        }
+    }
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+        sf::Vector2i clickPos(event.mouseButton.x, event.mouseButton.y);
+        float elapsed = clickClock.getElapsedTime().asSeconds();
+        bool isDoubleClick = false;
+
+        // ,     
+        if (elapsed < DOUBLE_CLICK_TIME) {
+            float distance = std::sqrt(std::pow(static_cast<float>(clickPos.x - lastClickPos.x), 2) + std::pow(static_cast<float>(clickPos.y - lastClickPos.y), 2));
+            if (distance < DOUBLE_CLICK_DISTANCE) {
+                isDoubleClick = true;
             }
+        }
 
-            //      
-            lastClickTime = clickClock.restart();
-            lastClickPos = clickPos;
-
-            int col = clickPos.x / TILE_SIZE;
-            int row = clickPos.y / TILE_SIZE;
-            if (row >= 0 && row < ROWS && col >= 0 && col < COLS) {
-                if (isDoubleClick && grid[row][col].bonus != BonusType::None) {
-                    //     -  
-                    applyBonus(grid[row][col].bonus, row, col);
-                    std::cout << "Bonus activated at (" << row << ", " << col << ")\n";
-
-                    //     
-                    if (firstSelected) {
-                        grid[selectedRow][selectedCol].isSelected = false;
-                        firstSelected = false;
-                    }
+        //      
+        lastClickTime = clickClock.restart();
+        lastClickPos = clickPos;
 
-                    //     
-                    applyGravity();
-                    //       
-                    std::vector<std::pair<int, int>> newMatches;
-                    int matchChecks = 0;
-                    while (checkMatches(newMatches) && matchChecks < MAX_MATCH_CHECKS) {
-                        removeMatches(newMatches);
-                        applyGravity();
-                        newMatches.clear();
-                        matchChecks++;
-                    }
-                }
-                else {
-                    if (!firstSelected) {
-                        firstSelected = true;
-                        selectedRow = row;
-                        selectedCol = col;
-                        grid[row][col].isSelected = true; // 
-                    }
-                    else {
-                        //   
-                        if (isAdjacent(selectedRow, selectedCol, row, col)) {
-                            swapTiles(selectedRow, selectedCol, row, col);
-                            //   
-                            std::vector<std::pair<int, int>> matches;
-                            if (!checkMatches(matches)) {
-                                //   ,  
-                                swapTiles(selectedRow, selectedCol, row, col);
-                            }
-                            else {
-                                //     
-                                removeMatches(matches);
-                                applyGravity();
-                                //     
-                                int matchChecks = 0;
-                                while (checkMatches(matches) && matchChecks < MAX_MATCH_CHECKS) {
-                                    removeMatches(matches);
-                                    applyGravity();
-                                    matches.clear();
-                                    matchChecks++;
-                                }
-                            }
-                        }
-                        //  
-                        grid[selectedRow][selectedCol].isSelected = false;
-                        firstSelected = false;
-                    }
-                }
+        int col = clickPos.x / TILE_SIZE;
+        int row = clickPos.y / TILE_SIZE;
+        if (row >= 0 && row < ROWS && col >= 0 && col < COLS) {
+            applyInput(SessionInput::click(row, col, isDoubleClick));
+        }
+    }
+}
+
+void Game::handleClick(int row, int col, bool isDoubleClick) {
+    //   ,    :    
+    if (!isSettled()) {
+        pendingInputs.push_back(SessionInput::click(row, col, isDoubleClick));
+        return;
+    }
+    clickTile(row, col, isDoubleClick);
+}
+
+void Game::clickTile(int row, int col, bool isDoubleClick) {
+    if (isDoubleClick && grid[row][col].bonus != BonusType::None) {
+        //     
+        if (firstSelected) {
+            grid[selectedRow][selectedCol].isSelected = false;
+            firstSelected = false;
+        }
+
+        //     -  
+        startMove(bonusMove(row, col));
+    }
+    else {
+        if (!firstSelected) {
+            firstSelected = true;
+            selectedRow = row;
+            selectedCol = col;
+            grid[row][col].isSelected = true; // 
+        }
+        else {
+            //  
+            grid[selectedRow][selectedCol].isSelected = false;
+            firstSelected = false;
+
+            //   
+            if (isAdjacent(selectedRow, selectedCol, row, col)) {
+                startMove(swapMove(selectedRow, selectedCol, row, col));
             }
         }
     }
 }
 
-void Game::update() {
-    //   
-    float deltaTime = clock.restart().asSeconds();
+Task Game::swapMove(int firstRow, int firstCol, int secondRow, int secondCol) {
+    moveStats = MoveStats();
+
+    swapTiles(firstRow, firstCol, secondRow, secondCol);
+    //   
+    std::vector<std::pair<int, int>> matches;
+    if (!checkMatches(matches, &moveStats.clusters)) {
+        //   ,     
+        co_await WaitFor{ CASCADE_STEP_TIME };
+        swapTiles(firstRow, firstCol, secondRow, secondCol);
+        co_return;
+    }
+
+    //  ,     
+    co_await WaitFor{ CASCADE_STEP_TIME };
+    removeMatches(matches);
+    co_await resolveCascades();
+    finishMove();
+}
+
+Task Game::bonusMove(int row, int col) {
+    moveStats = MoveStats();
+
+    co_await applyBonus(grid[row][col].bonus, row, col);
+    std::cout << "Bonus activated at (" << row << ", " << col << ")\n";
+
+    //          
+    co_await resolveCascades();
+    finishMove();
+}
+
+void Game::startMove(Task move) {
+    stepStart = std::chrono::steady_clock::now();
+    scheduler.start(std::move(move));
+    moveStats.busyNs += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - stepStart).count());
+    if (instantCascades) {
+        advanceMoves(0.0f);
+    }
+}
+
+void Game::advanceMoves(float deltaTime) {
+    if (!scheduler.idle()) {
+        stepStart = std::chrono::steady_clock::now();
+        if (instantCascades) {
+            scheduler.runAll();
+        }
+        else {
+            scheduler.update(deltaTime);
+        }
+        moveStats.busyNs += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - stepStart).count());
+    }
+
+    //     ,    
+    while (scheduler.idle() && !pendingInputs.empty()) {
+        SessionInput input = pendingInputs.front();
+        pendingInputs.pop_front();
+        dispatchInput(input);
+    }
+}
+
+void Game::update(float deltaTime) {
+    //     (  )
+    advanceMoves(deltaTime);
+
+    //   ,   
+    BonusRegistry& registry = BonusRegistry::getInstance();
     for (int row = 0; row < ROWS; ++row) {
         for (int col = 0; col < COLS; ++col) {
-            grid[row][col].updateFuse(deltaTime);
+            const BonusEffect* effect = registry.find(grid[row][col].bonus);
+            if (effect != nullptr && effect->showFuse) {
+                grid[row][col].updateFuse(deltaTime);
+            }
         }
     }
 
@@ -203,7 +423,8 @@ void Game::update() {
             continue;
         }
 
-        float elapsed = it->clock.getElapsedTime().asSeconds();
+        it->elapsed += deltaTime;
+        float elapsed = it->elapsed;
         if (elapsed > it->duration) {
             it = activeAnimations.erase(it);
             continue;
@@ -220,25 +441,43 @@ void Game::update() {
 }
 
 void Game::render() {
-    window.clear(sf::Color::Black);
+    draw(window);
+    window.display();
+}
+
+void Game::draw(sf::RenderTarget& target) {
+    target.clear(sf::Color::Black);
+    ResourceManager& rm = ResourceManager::getInstance();
+    BonusRegistry& registry = BonusRegistry::getInstance();
     for (int row = 0; row < ROWS; ++row) {
         for (int col = 0; col < COLS; ++col) {
-            window.draw(grid[row][col].shape);
-
-            //   ,  
-            if (grid[row][col].bonus == BonusType::Recolor) {
-                window.draw(grid[row][col].recolorIcon);
-                // ,   highlight    
-                grid[row][col].highlight.setPosition(grid[row][col].shape.getPosition());
-                window.draw(grid[row][col].highlight);
-            }
+            Tile& tile = grid[row][col];
+            target.draw(tile.shape);
+
+            //        
+            const BonusEffect* effect = registry.find(tile.bonus);
+            if (effect != nullptr) {
+                const sf::Vector2f& position = tile.shape.getPosition();
+                const sf::Vector2f& size = tile.shape.getSize();
+
+                if (!effect->iconTexture.empty() && rm.hasTexture(effect->iconTexture)) {
+                    const sf::Texture& texture = rm.getTexture(effect->iconTexture);
+                    if (tile.bonusIcon.getTexture() != &texture) {
+                        tile.bonusIcon.setTexture(texture, true);
+                    }
+                    sf::FloatRect bounds = tile.bonusIcon.getGlobalBounds();
+                    tile.bonusIcon.setPosition(position.x + size.x / 2 - bounds.width / 2, position.y + size.y / 2 - bounds.height / 2);
+                    target.draw(tile.bonusIcon);
+                }
+
+                if (effect->showFuse) {
+                    tile.fuse.setPosition(position.x + size.x - tile.fuse.getRadius() * 2, position.y + tile.fuse.getRadius() * 2);
+                    target.draw(tile.fuse);
+                }
 
-            //   
-            if (grid[row][col].bonus == BonusType::Bomb) {
-                window.draw(grid[row][col].fuse);
-                // ,   highlight    
-                grid[row][col].highlight.setPosition(grid[row][col].shape.getPosition());
-                window.draw(grid[row][col].highlight);
+                tile.highlight.setOutlineColor(effect->highlightColor);
+                tile.highlight.setPosition(position);
+                target.draw(tile.highlight);
             }
 
             //   
@@ -249,25 +488,23 @@ void Game::render() {
                 highlightShape.setOutlineThickness(3.0f);
                 highlightShape.setOutlineColor(sf::Color::White);
                 highlightShape.setPosition(grid[row][col].shape.getPosition());
-                window.draw(highlightShape);
+                target.draw(highlightShape);
             }
 
             //   overlay,  
             if (grid[row][col].isAnimating) {
-                window.draw(grid[row][col].animationOverlay);
+                target.draw(grid[row][col].animationOverlay);
             }
         }
     }
 
     //   
     for (const auto& anim : activeAnimations) {
-        window.draw(anim.shape);
+        target.draw(anim.shape);
     }
 
     //  
-    window.draw(scoreText);
-
-    window.display();
+    target.draw(scoreText);
 }
 
 bool Game::isAdjacent(int row1, int col1, int row2, int col2) {
@@ -286,19 +523,66 @@ bool Game::swapTiles(int firstRow, int firstCol, int secondRow, int secondCol) {
     grid[firstRow][firstCol].resetFuse();
     grid[secondRow][secondCol].resetFuse();
 
-    //   
-    grid[firstRow][firstCol].recolorIcon.setPosition(-100, -100);
-    grid[secondRow][secondCol].recolorIcon.setPosition(-100, -100);
+    //       (  highlight)
+    for (auto [r, c] : { std::make_pair(firstRow, firstCol), std::make_pair(secondRow, secondCol) }) {
+        const BonusEffect* effect = BonusRegistry::getInstance().find(grid[r][c].bonus);
+        if (effect != nullptr) {
+            assignBonus(r, c, *effect);
+        }
+        else {
+            clearBonus(r, c);
+        }
+    }
+
+    return true;
+}
+
+bool Game::checkInvariants(std::string& error, bool requireResolved) {
+    BonusRegistry& registry = BonusRegistry::getInstance();
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            const Tile& tile = grid[row][col];
+            std::string cell = " at (" + std::to_string(row) + ", " + std::to_string(col) + ")";
+
+            //       
+            if (tile.color < 0 || tile.color >= NUM_COLORS) {
+                error = "invalid color " + std::to_string(tile.color) + cell;
+                return false;
+            }
+
+            //      
+            const BonusEffect* effect = registry.find(tile.bonus);
+            if (tile.bonus != BonusType::None && effect == nullptr) {
+                error = "unregistered bonus" + cell;
+                return false;
+            }
+            sf::Color expected = effect != nullptr ? effect->highlightColor : sf::Color::Transparent;
+            if (tile.highlight.getOutlineColor() != expected) {
+                error = "bonus highlight mismatch" + cell;
+                return false;
+            }
+
+            //     
+            bool shouldBeSelected = firstSelected && row == selectedRow && col == selectedCol;
+            if (tile.isSelected != shouldBeSelected) {
+                error = "stale selection" + cell;
+                return false;
+            }
+        }
+    }
 
-    //  highlight
-    grid[firstRow][firstCol].highlight.setOutlineColor(sf::Color::Transparent);
-    grid[secondRow][secondCol].highlight.setOutlineColor(sf::Color::Transparent);
+    //      ( MAX_MATCH_CHECKS)
+    std::vector<std::pair<int, int>> matches;
+    if (requireResolved && checkMatches(matches)) {
+        error = "unresolved matches left on board (" + std::to_string(matches.size()) + " cells)";
+        return false;
+    }
 
     return true;
 }
 
 //  checkMatches  
-bool Game::checkMatches(std::vector<std::pair<int, int>>& matchesOut) {
+bool Game::checkMatches(std::vector<std::pair<int, int>>& matchesOut, int* clustersOut) {
     bool found = false;
     std::vector<std::vector<bool>> visited(ROWS, std::vector<bool>(COLS, false));
 
@@ -339,6 +623,9 @@ bool Game::checkMatches(std::vector<std::pair<int, int>>& matchesOut) {
             if (cluster.size() >= 3) {
                 matchesOut.insert(matchesOut.end(), cluster.begin(), cluster.end());
                 found = true;
+                if (clustersOut != nullptr) {
+                    ++*clustersOut;
+                }
             }
         }
     }
@@ -356,16 +643,22 @@ void Game::removeMatches(const std::vector<std::pair<int, int>>& matches, bool g
     if (matches.empty()) return;
 
     std::uniform_real_distribution<float> realDist(0.0f, 1.0f);
-    std::uniform_int_distribution<int> bonusDist(1, 2);
     std::uniform_int_distribution<int> offsetDist(-3, 3);
 
-    ResourceManager& rm = ResourceManager::getInstance();
+    BonusRegistry& registry = BonusRegistry::getInstance();
+
+    moveStats.cascadeDepth++;
+    moveStats.cellsCleared += static_cast<int>(matches.size());
+
+    //       O(1)
+    CellMask destroyed;
+    for (auto& [row, col] : matches) {
+        destroyed.insert(row, col);
+    }
 
     for (auto& [row, col] : matches) {
         //    
-        grid[row][col].color = -1;
-        grid[row][col].shape.setFillColor(sf::Color::Black);
-        grid[row][col].resetFuse();
+        clearCell(row, col);
 
         //  
         score += 10;
@@ -381,30 +674,15 @@ void Game::removeMatches(const std::vector<std::pair<int, int>>& matches, bool g
                 int bonusCol = col + colOffset;
                 if (bonusRow >= 0 && bonusRow < ROWS && bonusCol >= 0 && bonusCol < COLS) {
                     // ,        
-                    bool isBeingDestroyed = std::find(matches.begin(), matches.end(), std::make_pair(bonusRow, bonusCol)) != matches.end();
-                    if (!isBeingDestroyed && grid[bonusRow][bonusCol].bonus == BonusType::None && grid[bonusRow][bonusCol].color != -1) {
-                        //  
-                        grid[bonusRow][bonusCol].bonus = static_cast<BonusType>(bonusDist(rng));
-                        std::cout << "Bonus spawned at (" << bonusRow << ", " << bonusCol << ") Type: "
-                            << (grid[bonusRow][bonusCol].bonus == BonusType::Recolor ? "Recolor" : "Bomb") << "\n";
-                        bonusAssigned = true;
-
-                        //  highlight  
-                        if (grid[bonusRow][bonusCol].bonus == BonusType::Recolor) {
-                            grid[bonusRow][bonusCol].highlight.setOutlineColor(sf::Color::Cyan);
-
-                            //   ,   
-                            if (rm.getTexture("recolor_icon").getSize().x > 0) {
-                                grid[bonusRow][bonusCol].recolorIcon.setTexture(rm.getTexture("recolor_icon"));
-                                grid[bonusRow][bonusCol].recolorIcon.setPosition(
-                                    grid[bonusRow][bonusCol].shape.getPosition().x + grid[bonusRow][bonusCol].shape.getSize().x / 2 - grid[bonusRow][bonusCol].recolorIcon.getGlobalBounds().width / 2,
-                                    grid[bonusRow][bonusCol].shape.getPosition().y + grid[bonusRow][bonusCol].shape.getSize().y / 2 - grid[bonusRow][bonusCol].recolorIcon.getGlobalBounds().height / 2
-                                );
-                            }
-                        }
-                        else if (grid[bonusRow][bonusCol].bonus == BonusType::Bomb) {
-                            grid[bonusRow][bonusCol].highlight.setOutlineColor(sf::Color::Red);
+                    if (!destroyed.contains(bonusRow, bonusCol) && grid[bonusRow][bonusCol].bonus == BonusType::None && grid[bonusRow][bonusCol].color != -1) {
+                        const BonusEffect* effect = registry.find(registry.pickSpawnable(rng));
+                        if (effect == nullptr) {
+                            break;
                         }
+                        assignBonus(bonusRow, bonusCol, *effect);
+                        Metrics::getInstance().bonusSpawned.increment(effect->type);
+                        std::cout << "Bonus spawned at (" << bonusRow << ", " << bonusCol << ") Type: " << effect->name << "\n";
+                        bonusAssigned = true;
                     }
                 }
             }
@@ -415,6 +693,26 @@ void Game::removeMatches(const std::vector<std::pair<int, int>>& matches, bool g
     scoreText.setString("Score: " + std::to_string(score));
 }
 
+void Game::clearCell(int row, int col) {
+    //    ,      
+    grid[row][col].color = -1;
+    grid[row][col].shape.setFillColor(sf::Color::Black);
+    grid[row][col].resetFuse();
+}
+
+void Game::assignBonus(int row, int col, const BonusEffect& effect) {
+    grid[row][col].bonus = effect.type;
+
+    //  highlight   (   draw    )
+    grid[row][col].highlight.setOutlineColor(effect.highlightColor);
+}
+
+void Game::clearBonus(int row, int col) {
+    grid[row][col].bonus = BonusType::None;
+    grid[row][col].resetFuse();
+    grid[row][col].highlight.setOutlineColor(sf::Color::Transparent); //  
+}
+
 void Game::applyGravity() {
     for (int col = 0; col < COLS; ++col) {
         int empty = ROWS - 1;
@@ -426,12 +724,6 @@ void Game::applyGravity() {
                     grid[empty][col].bonus = grid[row][col].bonus;
                     grid[empty][col].shape.setFillColor(colors[grid[empty][col].color]);
 
-                    //  ,  
-                    grid[empty][col].fuse.setPosition(grid[row][col].fuse.getPosition());
-
-                    //   
-                    grid[empty][col].recolorIcon.setPosition(grid[row][col].recolorIcon.getPosition());
-
                     //  highlight
                     grid[empty][col].highlight.setOutlineColor(grid[row][col].highlight.getOutlineColor());
 
@@ -440,15 +732,10 @@ void Game::applyGravity() {
                     grid[empty][col].animationOverlay.setPosition(grid[row][col].animationOverlay.getPosition());
 
                     //   
-                    grid[row][col].color = -1;
+                    clearCell(row, col);
                     grid[row][col].bonus = BonusType::None;
-                    grid[row][col].shape.setFillColor(sf::Color::Black);
-                    grid[row][col].fuse.setPosition(-10, -10);
                     grid[row][col].isSelected = false;
 
-                    //   
-                    grid[row][col].recolorIcon.setPosition(-100, -100);
-
                     //  highlight
                     grid[row][col].highlight.setOutlineColor(sf::Color::Transparent);
 
@@ -466,12 +753,9 @@ void Game::applyGravity() {
             grid[row][col].bonus = BonusType::None; //    
 
             grid[row][col].shape.setFillColor(colors[grid[row][col].color]);
-            grid[row][col].fuse.setPosition(-10, -10);
+            grid[row][col].resetFuse();
             grid[row][col].isSelected = false;
 
-            //   
-            grid[row][col].recolorIcon.setPosition(-100, -100);
-
             //  highlight (  )
             grid[row][col].highlight.setOutlineColor(sf::Color::Transparent);
 
@@ -481,134 +765,146 @@ void Game::applyGravity() {
     }
 }
 
-void Game::applyBonus(BonusType bonus, int row, int col) {
-    ResourceManager& rm = ResourceManager::getInstance();
+Task Game::resolveCascades() {
+    //   (,   )     
+    co_await WaitFor{ CASCADE_STEP_TIME };
+    applyGravity();
+    std::vector<std::pair<int, int>> matches;
+    int matchChecks = 0;
+    //   : ,     ,     
+    while (matchChecks < MAX_MATCH_CHECKS && checkMatches(matches, &moveStats.clusters)) {
+        co_await WaitFor{ CASCADE_STEP_TIME };
+        removeMatches(matches);
+        co_await WaitFor{ CASCADE_STEP_TIME };
+        applyGravity();
+        matches.clear();
+        matchChecks++;
+    }
+}
 
-    if (bonus == BonusType::Recolor) {
-        //   Recolor
-        recolorSound.play();
+void Game::finishMove() {
+    //        :    
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - stepStart);
+    Metrics::getInstance().recordMove(moveStats.cascadeDepth, moveStats.clusters, moveStats.cellsCleared,
+        moveStats.busyNs + static_cast<std::uint64_t>(latency.count()));
+    history.push(captureSnapshot());
+}
 
-        std::cout << "Applying Recolor bonus at (" << row << ", " << col << ")\n";
+void Game::showHint() {
+    //       ,    
+    if (!isSettled()) {
+        std::cout << "Hint: wait until the current move finishes\n";
+        return;
+    }
 
-        //   
-        Animation anim;
-        anim.shape.setSize(sf::Vector2f(static_cast<float>(TILE_SIZE - 2), static_cast<float>(TILE_SIZE - 2)));
-        anim.shape.setFillColor(sf::Color::White);
-        anim.shape.setPosition(grid[row][col].shape.getPosition());
-        anim.duration = 0.5f;
-        anim.active = true;
-        anim.clock.restart();
-        activeAnimations.push_back(anim);
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    MoveEvaluator evaluator(transpositionTable, HINT_SEARCH_DEPTH, threads);
+    MoveChoice best = evaluator.findBest(captureSnapshot());
 
-        //    2    3
-        std::vector<std::pair<int, int>> vicinity;
-        for (int r = std::max(0, row - 3); r <= std::min(ROWS - 1, row + 3); ++r) {
-            for (int c = std::max(0, col - 3); c <= std::min(COLS - 1, col + 3); ++c) {
-                if (r == row && c == col) continue;
-                vicinity.emplace_back(r, c);
-            }
-        }
-        //  2 
-        std::shuffle(vicinity.begin(), vicinity.end(), rng);
-        int recolorColor = grid[row][col].color;
-        grid[row][col].shape.setFillColor(colors[recolorColor]); //   
-        if (vicinity.size() >= 2) {
-            grid[vicinity[0].first][vicinity[0].second].color = recolorColor;
-            grid[vicinity[0].first][vicinity[0].second].shape.setFillColor(colors[recolorColor]);
-            grid[vicinity[1].first][vicinity[1].second].color = recolorColor;
-            grid[vicinity[1].first][vicinity[1].second].shape.setFillColor(colors[recolorColor]);
-            //    
-            score += 10;
-            scoreText.setString("Score: " + std::to_string(score));
-
-            //     
-            grid[vicinity[0].first][vicinity[0].second].bonus = BonusType::None;
-            grid[vicinity[1].first][vicinity[1].second].bonus = BonusType::None;
-
-            //     highlight
-            grid[vicinity[0].first][vicinity[0].second].recolorIcon.setPosition(-100, -100);
-            grid[vicinity[0].first][vicinity[0].second].highlight.setOutlineColor(sf::Color::Transparent);
-
-            grid[vicinity[1].first][vicinity[1].second].recolorIcon.setPosition(-100, -100);
-            grid[vicinity[1].first][vicinity[1].second].highlight.setOutlineColor(sf::Color::Transparent);
-        }
+    TranspositionTable::Stats stats = transpositionTable.getStats();
+    std::cout << "Transposition table: " << stats.hits << "/" << stats.probes << " hits ("
+        << static_cast<int>(stats.hitRate() * 100.0) << "%)\n";
 
-        //   Recolor  
-        grid[row][col].bonus = BonusType::None;
-        grid[row][col].recolorIcon.setPosition(-100, -100); //     
-        grid[row][col].highlight.setOutlineColor(sf::Color::Transparent); //  
-        std::cout << "Recolor bonus at (" << row << ", " << col << ") has been reset.\n";
+    if (best.kind == MoveChoice::Kind::None) {
+        std::cout << "Hint: no moves available\n";
+        return;
+    }
+    if (best.kind == MoveChoice::Kind::Bonus) {
+        std::cout << "Hint: activate bonus at (" << best.row << ", " << best.col << "), value " << best.value << "\n";
+    }
+    else {
+        std::cout << "Hint: swap (" << best.row << ", " << best.col << ") with (" << best.otherRow << ", " << best.otherCol
+            << "), value " << best.value << "\n";
     }
-    else if (bonus == BonusType::Bomb) {
-        //   Bomb
-        bombSound.play();
-
-        std::cout << "Applying Bomb bonus at (" << row << ", " << col << ")\n";
 
-        //   
+    //     
+    for (auto [r, c] : { std::make_pair(best.row, best.col), std::make_pair(best.otherRow, best.otherCol) }) {
         Animation anim;
         anim.shape.setSize(sf::Vector2f(static_cast<float>(TILE_SIZE - 2), static_cast<float>(TILE_SIZE - 2)));
-        anim.shape.setFillColor(sf::Color::Red);
-        anim.shape.setPosition(grid[row][col].shape.getPosition());
-        anim.duration = 0.5f;
+        anim.shape.setFillColor(sf::Color::White);
+        anim.shape.setPosition(grid[r][c].shape.getPosition());
+        anim.duration = 1.0f;
         anim.active = true;
-        anim.clock.restart();
         activeAnimations.push_back(anim);
+    }
+}
 
-        //  5  ,  
-        std::vector<std::pair<int, int>> tilesToDestroy = { {row, col} };
-        std::vector<std::pair<int, int>> candidates;
-        for (int r = 0; r < ROWS; ++r) {
-            for (int c = 0; c < COLS; ++c) {
-                if (r != row || c != col) {
-                    candidates.emplace_back(r, c);
-                }
-            }
-        }
-        std::shuffle(candidates.begin(), candidates.end(), rng);
-        for (int i = 0; i < 4 && i < static_cast<int>(candidates.size()); ++i) {
-            tilesToDestroy.emplace_back(candidates[i]);
-        }
-        for (auto& [r, c] : tilesToDestroy) {
-            grid[r][c].color = -1;
-            grid[r][c].bonus = BonusType::None;
+//     :          
+class Game::BonusView : public BonusBoard {
+public:
+    explicit BonusView(Game& game) : game(game) {}
 
-            //   ,   
-            grid[r][c].fuse.setPosition(-10, -10);
+    CellState cellAt(int row, int col) const override {
+        const Tile& tile = game.grid[row][col];
+        return { tile.color, tile.bonus };
+    }
 
-            //     
-            score += 20;
-            scoreText.setString("Score: " + std::to_string(score));
+    void clearCell(int row, int col) override {
+        game.clearCell(row, col);
+        game.moveStats.cellsCleared++;
+    }
 
-            //     highlight
-            grid[r][c].recolorIcon.setPosition(-100, -100);
-            grid[r][c].highlight.setOutlineColor(sf::Color::Transparent);
-        }
+    void recolorCell(int row, int col, int color) override {
+        game.grid[row][col].color = color;
+        game.grid[row][col].shape.setFillColor(game.colors[color]);
+    }
 
-        //   Bomb  
-        grid[row][col].bonus = BonusType::None;
-        grid[row][col].fuse.setPosition(-10, -10); //  
-        grid[row][col].highlight.setOutlineColor(sf::Color::Transparent); //  
-        std::cout << "Bomb bonus at (" << row << ", " << col << ") has been reset.\n";
+    void clearBonus(int row, int col) override {
+        game.clearBonus(row, col);
+    }
 
-        //     
-        applyGravity();
+private:
+    Game& game;
+};
 
-        //       
-        std::vector<std::pair<int, int>> newMatches;
-        int matchChecks = 0;
-        while (checkMatches(newMatches) && matchChecks < MAX_MATCH_CHECKS) {
-            removeMatches(newMatches);
-            applyGravity();
-            newMatches.clear();
-            matchChecks++;
-        }
+Task Game::applyBonus(BonusType bonus, int row, int col) {
+    const BonusEffect* effect = BonusRegistry::getInstance().find(bonus);
+    if (effect == nullptr) {
+        co_return;
     }
+
+    //   
+    auto sound = bonusSounds.find(bonus);
+    if (sound != bonusSounds.end()) {
+        sound->second.play();
+    }
+
+    Metrics::getInstance().bonusActivated.increment(bonus);
+
+    std::cout << "Applying " << effect->name << " bonus at (" << row << ", " << col << ")\n";
+
+    //   
+    Animation anim;
+    anim.shape.setSize(sf::Vector2f(static_cast<float>(TILE_SIZE - 2), static_cast<float>(TILE_SIZE - 2)));
+    anim.shape.setFillColor(effect->animationColor);
+    anim.shape.setPosition(grid[row][col].shape.getPosition());
+    anim.duration = 0.5f;
+    anim.active = true;
+    activeAnimations.push_back(anim);
+
+    //    ,     
+    BonusView view(*this);
+    CellMask mask;
+    effect->kernel(view, row, col, rng, mask);
+
+    //   ,    
+    for (auto& [r, c] : mask.getCells()) {
+        Animation cellAnim = anim;
+        cellAnim.shape.setPosition(grid[r][c].shape.getPosition());
+        cellAnim.duration = BONUS_STEP_TIME;
+        activeAnimations.push_back(cellAnim);
+    }
+    co_await WaitFor{ BONUS_STEP_TIME };
+    score += applyBonusEffect(*effect, view, mask, row, col);
+    scoreText.setString("Score: " + std::to_string(score));
+    std::cout << effect->name << " bonus at (" << row << ", " << col << ") has been reset.\n";
+
+    //        (bonusMove)
 }
 
 void Game::activateBomb(int row, int col) {
     if (grid[row][col].bonus != BonusType::Bomb) {
         return;
     }
-    applyBonus(BonusType::Bomb, row, col);
+    startMove(bonusMove(row, col));
 }
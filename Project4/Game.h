@@ -6,28 +6,95 @@
 #include <SFML/Audio.hpp>
 #include <vector>
 #include <random>
+#include <map>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
 #include "Tile.h"
 #include "Constants.h"
 #include "ResourceManager.h"
+#include "BonusEffects.h"
+#include "Metrics.h"
+#include "BoardGenerator.h"
+#include "BoardHistory.h"
+#include "MoveEvaluator.h"
+#include "Session.h"
+#include "CoroutineScheduler.h"
+#include "LiveState.h"
 
 class Game {
 public:
     Game();
+    Game(unsigned int seed, bool headless);
     void run();
 
+    //     (  )
+    void handleEvent(const sf::Event& event);
+
+    //     (   -).
+    //   ,      
+    void handleClick(int row, int col, bool isDoubleClick);
+
+    //     ;   applyInput   
+    void beginSession(const ColorGrid& board, unsigned int seed);
+    void applyInput(const SessionInput& input);
+    const Session& getSession() const { return session; }
+
+    //     (   )     
+    void setInstantCascades(bool instant) { instantCascades = instant; }
+
+    //      
+    bool isSettled() const { return scheduler.idle() && pendingInputs.empty(); }
+
+    //        (  )
+    void update(float deltaTime);
+    void draw(sf::RenderTarget& target);
+
+    //   ;    error.
+    // requireResolved -      
+    bool checkInvariants(std::string& error, bool requireResolved = true);
+
+    //     (:    )
+    BoardSnapshot captureSnapshot() const;
+    void restoreSnapshot(const BoardSnapshot& snapshot);
+
+    //     (   ,  false)
+    bool undo();
+    bool redo();
+
+    int getScore() const { return score; }
+    const std::vector<std::vector<Tile>>& getGrid() const { return grid; }
+
 private:
+    class BonusView; //      (BonusBoard)
+
     void processEvents();
-    void update();
     void render();
 
-    void initializeGrid();
+    void initializeGrid(unsigned int seed);
+    void loadBoard(const ColorGrid& board);
     bool swapTiles(int firstRow, int firstCol, int secondRow, int secondCol);
-    bool checkMatches(std::vector<std::pair<int, int>>& matchesOut);
+    bool checkMatches(std::vector<std::pair<int, int>>& matchesOut, int* clustersOut = nullptr);
     void removeMatches(const std::vector<std::pair<int, int>>& matches, bool generateBonuses = true);
     void applyGravity();
-    void applyBonus(BonusType bonus, int row, int col);
+    void clickTile(int row, int col, bool isDoubleClick);
+    bool restoreFromHistory(const BoardSnapshot* snapshot);
+    void dispatchInput(const SessionInput& input);
+    void startMove(Task move);
+    void advanceMoves(float deltaTime);
+    Task swapMove(int firstRow, int firstCol, int secondRow, int secondCol);
+    Task bonusMove(int row, int col);
+    Task resolveCascades();
+    Task applyBonus(BonusType bonus, int row, int col);
+    void clearCell(int row, int col);
+    void assignBonus(int row, int col, const BonusEffect& effect);
+    void clearBonus(int row, int col);
     bool isAdjacent(int row1, int col1, int row2, int col2);
     void activateBomb(int row, int col);
+    void finishMove();
+    void publishLiveState(float deltaTime, std::chrono::steady_clock::duration workTime);
+    void showHint();
 
     sf::RenderWindow window;
     std::vector<std::vector<Tile>> grid;
@@ -46,6 +113,18 @@ private:
     //   
     std::mt19937 rng;
 
+    //      (   )
+    std::unique_ptr<BoardPool> boardPool;
+
+    //    undo/redo
+    BoardHistory history;
+
+    //   
+    Session session;
+
+    //     
+    TranspositionTable transpositionTable;
+
     //  
     std::vector<sf::Color> colors;
 
@@ -56,18 +135,38 @@ private:
     int score;
     sf::Text scoreText;
 
-    //  
-    sf::Sound bombSound;
-    sf::Sound recolorSound;
+    //   
+    std::map<BonusType, sf::Sound> bonusSounds;
+
+    //   ;      ,
+    //        
+    CoroutineScheduler scheduler;
+    std::deque<SessionInput> pendingInputs;
+    bool instantCascades;
+
+    //     
+    struct MoveStats {
+        int cascadeDepth = 0;
+        int clusters = 0;
+        int cellsCleared = 0;
+        std::uint64_t busyNs = 0; //       
+    };
+    MoveStats moveStats;
+    std::chrono::steady_clock::time_point stepStart;
+    MetricsExporter metricsExporter;
+
+    //      (  )
+    LiveStatePublisher liveState;
+    LiveStateData liveData;
 
     // 
     struct Animation {
         sf::RectangleShape shape;
-        sf::Clock clock;
+        float elapsed;
         float duration;
         bool active;
 
-        Animation() : duration(0.5f), active(false) {}
+        Animation() : elapsed(0.0f), duration(0.5f), active(false) {}
     };
 
     std::vector<Animation> activeAnimations;
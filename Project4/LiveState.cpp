@@ -0,0 +1,274 @@
+// LiveState.cpp
+#include "LiveState.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::uint64_t currentProcessId() {
+#if defined(_WIN32)
+        return GetCurrentProcessId();
+#else
+        return static_cast<std::uint64_t>(getpid());
+#endif
+    }
+
+#if !defined(_WIN32)
+    //   ,     flock.   ,  
+    //  (   ),       - ,
+    //    .       ,    
+    //    . flock,   fcntl: fcntl-   
+    //       ,     .
+    //      -1; busy -    .
+    int lockSegment(const std::string& path, bool& busy) {
+        busy = false;
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            int descriptor = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (descriptor < 0 && errno == EEXIST) {
+                descriptor = shm_open(path.c_str(), O_RDWR, 0);
+            }
+            if (descriptor < 0) {
+                if (errno == ENOENT) {
+                    continue; //       
+                }
+                return -1;
+            }
+            if (flock(descriptor, LOCK_EX | LOCK_NB) != 0) {
+                busy = errno == EWOULDBLOCK;
+                ::close(descriptor);
+                return -1;
+            }
+
+            //       ,    :
+            //     ,   
+            int current = shm_open(path.c_str(), O_RDONLY, 0);
+            struct stat locked;
+            struct stat named;
+            bool same = current >= 0 && fstat(descriptor, &locked) == 0 && fstat(current, &named) == 0
+                && locked.st_dev == named.st_dev && locked.st_ino == named.st_ino;
+            if (current >= 0) {
+                ::close(current);
+            }
+            if (same) {
+                return descriptor;
+            }
+            ::close(descriptor);
+        }
+        return -1;
+    }
+#endif
+}
+
+bool SharedMemoryMapping::open(const std::string& segmentName, std::size_t segmentSize, bool create) {
+    close();
+    name = segmentName;
+    size = segmentSize;
+    existed = false;
+
+#if defined(_WIN32)
+    std::string path = "Local\\" + name;
+    handle = create
+        ? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(size), path.c_str())
+        : OpenFileMappingA(FILE_MAP_READ, FALSE, path.c_str());
+    if (handle == nullptr) {
+        return false;
+    }
+    //    CreateFileMapping    
+    if (create && GetLastError() == ERROR_ALREADY_EXISTS) {
+        close();
+        existed = true;
+        return false;
+    }
+    owner = create;
+    address = MapViewOfFile(handle, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size);
+    if (address == nullptr) {
+        close();
+        return false;
+    }
+#else
+    std::string path = "/" + name;
+    descriptor = create ? lockSegment(path, existed) : shm_open(path.c_str(), O_RDONLY, 0);
+    if (descriptor < 0) {
+        return false;
+    }
+    owner = create; //   ( ):    close()  
+    if (create && ftruncate(descriptor, static_cast<off_t>(size)) != 0) {
+        close();
+        return false;
+    }
+    //    (    )   SIGBUS  
+    struct stat info;
+    if (!create && (fstat(descriptor, &info) != 0 || info.st_size < static_cast<off_t>(size))) {
+        close();
+        return false;
+    }
+    void* mapped = mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descriptor, 0);
+    if (mapped == MAP_FAILED) {
+        close();
+        return false;
+    }
+    address = mapped;
+#endif
+    return true;
+}
+
+void SharedMemoryMapping::close() {
+#if defined(_WIN32)
+    //  Windows      
+    if (address != nullptr) {
+        UnmapViewOfFile(address);
+    }
+    if (handle != nullptr) {
+        CloseHandle(handle);
+    }
+#else
+    if (address != nullptr) {
+        munmap(address, size);
+    }
+    if (descriptor >= 0) {
+        //   ,   ,    ( );
+        //      
+        if (owner) {
+            shm_unlink(("/" + name).c_str());
+        }
+        ::close(descriptor);
+    }
+#endif
+    address = nullptr;
+    handle = nullptr;
+    descriptor = -1;
+    owner = false;
+}
+
+bool LiveStatePublisher::open(const std::string& name) {
+    if (!mapping.open(name, sizeof(LiveStateBlock), true)) {
+        if (mapping.alreadyExists()) {
+            SharedMemoryMapping other;
+            std::uint64_t pid = 0;
+            if (other.open(name, sizeof(LiveStateBlock), false)) {
+                pid = static_cast<const LiveStateBlock*>(other.get())->ownerPid.load(std::memory_order_relaxed);
+            }
+            std::cerr << "        (pid " << pid << "): " << name << "\n";
+        }
+        else {
+            std::cerr << "       : " << name << "\n";
+        }
+        return false;
+    }
+
+    //    :      ,    .
+    //    ,    magic
+    LiveStateBlock* block = new (mapping.get()) LiveStateBlock;
+    block->ownerPid.store(currentProcessId(), std::memory_order_relaxed);
+    block->magic.store(0, std::memory_order_relaxed);
+    block->version = LiveStateBlock::VERSION;
+    block->sequence.store(0, std::memory_order_relaxed);
+    for (auto& word : block->words) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    block->magic.store(LiveStateBlock::MAGIC, std::memory_order_release);
+    return true;
+}
+
+void LiveStatePublisher::publish(const LiveStateData& data) {
+    LiveStateBlock* block = static_cast<LiveStateBlock*>(mapping.get());
+    if (block == nullptr) {
+        return;
+    }
+
+    std::uint64_t words[LiveStateBlock::WORDS];
+    words[LiveStateBlock::WORDS - 1] = 0;
+    std::memcpy(words, &data, sizeof(data));
+
+    //    ,  sequence   RMW
+    std::uint64_t sequence = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < LiveStateBlock::WORDS; ++i) {
+        block->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    block->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool LiveStateReader::open(const std::string& name) {
+    return mapping.open(name, sizeof(LiveStateBlock), false);
+}
+
+bool LiveStateReader::read(LiveStateData& data) const {
+    const LiveStateBlock* block = static_cast<const LiveStateBlock*>(mapping.get());
+    if (block == nullptr || block->magic.load(std::memory_order_acquire) != LiveStateBlock::MAGIC
+        || block->version != LiveStateBlock::VERSION) {
+        return false;
+    }
+
+    std::uint64_t words[LiveStateBlock::WORDS];
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        std::uint64_t before = block->sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false; //      
+        }
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (int i = 0; i < LiveStateBlock::WORDS; ++i) {
+            words[i] = block->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block->sequence.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&data, words, sizeof(data));
+            return data.rows >= 0 && data.cols >= 0 && data.rows * data.cols <= LIVE_STATE_MAX_CELLS;
+        }
+    }
+    return false;
+}
+
+std::uint64_t LiveStateReader::sequence() const {
+    const LiveStateBlock* block = static_cast<const LiveStateBlock*>(mapping.get());
+    return block != nullptr ? block->sequence.load(std::memory_order_acquire) / 2 : 0;
+}
+
+void writeLiveState(std::ostream& out, const LiveStateData& data) {
+    double frameMs = static_cast<double>(data.frameTimeNs) / 1e6;
+    double workMs = static_cast<double>(data.workTimeNs) / 1e6;
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "frame " << data.frame << "  score " << data.score << "  " << (data.settled ? "settled" : "moving")
+        << "  frame time " << std::fixed << std::setprecision(2) << frameMs << " ms (work " << workMs << " ms)\n";
+
+    //  ,    ( )
+    for (int row = 0; row < data.rows; ++row) {
+        for (int col = 0; col < data.cols; ++col) {
+            int color = data.colors[row * data.cols + col];
+            out << (col > 0 ? " " : "") << (color >= 0 ? static_cast<char>('0' + color) : '.');
+        }
+        out << "\n";
+    }
+    bool any = false;
+    for (int cell = 0; cell < data.rows * data.cols; ++cell) {
+        if (data.bonuses[cell] != 0) {
+            out << (any ? " " : "bonuses:") << " (" << cell / data.cols << ", " << cell % data.cols << ")=" << static_cast<int>(data.bonuses[cell]);
+            any = true;
+        }
+    }
+    if (any) {
+        out << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,109 @@
+// LiveState.h
+#ifndef LIVESTATE_H
+#define LIVESTATE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+//          (, , ).
+//     SFML  Game:    LiveState.cpp     .
+
+//  : "/gems_live_state" (POSIX shm)  "Local\gems_live_state" (Windows)
+const char* const LIVE_STATE_NAME = "gems_live_state";
+
+//  :   16x16 
+const int LIVE_STATE_MAX_CELLS = 256;
+
+//   
+struct LiveStateData {
+    std::int32_t rows;
+    std::int32_t cols;
+    std::int32_t score;
+    std::int32_t settled;           // 1 -   ,  
+    std::uint64_t frame;            //     
+    std::uint64_t frameTimeNs;      //    (  )
+    std::uint64_t workTimeNs;       //  : ,   
+    std::int8_t colors[LIVE_STATE_MAX_CELLS];   //   , -1 -  
+    std::uint8_t bonuses[LIVE_STATE_MAX_CELLS]; // BonusType  
+};
+
+//  .   64-   relaxed-,   seqlock:
+//  sequence -  ,   ,  sequence .
+struct LiveStateBlock {
+    static const std::uint32_t MAGIC = 0x47454D53; // "GEMS"
+    static const std::uint32_t VERSION = 2;
+    static const int WORDS = (sizeof(LiveStateData) + 7) / 8;
+
+    std::atomic<std::uint32_t> magic;  //     
+    std::uint32_t version;
+    std::atomic<std::uint64_t> ownerPid; // - ( )
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> words[WORDS];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "seqlock     lock-free ");
+
+//      ( )
+class SharedMemoryMapping {
+public:
+    SharedMemoryMapping() : address(nullptr), size(0), handle(nullptr), descriptor(-1), owner(false), existed(false) {}
+    ~SharedMemoryMapping() { close(); }
+
+    SharedMemoryMapping(const SharedMemoryMapping&) = delete;
+    SharedMemoryMapping& operator=(const SharedMemoryMapping&) = delete;
+
+    // create -   ()    ().
+    //        ;   
+    //  , open  false  alreadyExists() - true
+    bool open(const std::string& name, std::size_t size, bool create);
+    void close();
+
+    void* get() const { return address; }
+    bool alreadyExists() const { return existed; }
+
+private:
+    std::string name;
+    void* address;
+    std::size_t size;
+    void* handle;    // HANDLE  (Windows)
+    int descriptor;  //  shm (POSIX)
+    bool owner;      //    :      
+    bool existed;    //    ,      
+};
+
+//    :     ,    
+class LiveStatePublisher {
+public:
+    bool open(const std::string& name = LIVE_STATE_NAME);
+    void close() { mapping.close(); }
+    bool isOpen() const { return mapping.get() != nullptr; }
+
+    void publish(const LiveStateData& data);
+
+private:
+    SharedMemoryMapping mapping;
+};
+
+//    :     
+class LiveStateReader {
+public:
+    bool open(const std::string& name = LIVE_STATE_NAME);
+    void close() { mapping.close(); }
+
+    // false -   ,        
+    bool read(LiveStateData& data) const;
+
+    //   :    ,    
+    std::uint64_t sequence() const;
+
+private:
+    SharedMemoryMapping mapping;
+};
+
+//    ( --dump-live)
+void writeLiveState(std::ostream& out, const LiveStateData& data);
+
+#endif // LIVESTATE_H
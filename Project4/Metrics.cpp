@@ -0,0 +1,188 @@
+// Metrics.cpp
+#include "Metrics.h"
+#include "BonusEffects.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+Histogram::Histogram(const char* name, const char* help, int exportMaxBits)
+    : name(name), help(help), exportMaxBits(exportMaxBits), sum(0) {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t Histogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<std::uint64_t>(index);
+    }
+    int shift = index / SUB_BUCKETS - 1;
+    std::uint64_t lower = static_cast<std::uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + (std::uint64_t(1) << shift) - 1;
+}
+
+std::uint64_t Histogram::valueAtQuantile(double quantile) const {
+    //  :    ,   total   
+    std::array<std::uint64_t, BUCKET_COUNT> snapshot;
+    std::uint64_t total = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        snapshot[i] = counts[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    //   ( 1) -  ,  p90  {33, 40}   33
+    double rank = std::ceil(quantile * static_cast<double>(total));
+    std::uint64_t target = static_cast<std::uint64_t>(std::min(std::max(rank, 1.0), static_cast<double>(total)));
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += snapshot[i];
+        if (seen >= target) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKET_COUNT - 1);
+}
+
+void Histogram::write(std::ostream& out) const {
+    std::array<std::uint64_t, BUCKET_COUNT> snapshot;
+    std::uint64_t total = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        snapshot[i] = counts[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " histogram\n";
+
+    //  le = 2^bits - 1:     HDR-,    le
+    //    <= le (  -   ,   )
+    std::uint64_t cumulative = 0;
+    int next = 0;
+    for (int bits = 0; bits <= exportMaxBits; ++bits) {
+        std::uint64_t le = (std::uint64_t(1) << bits) - 1;
+        int last = bucketIndex(le);
+        assert(bucketUpperBound(last) == le);
+        for (; next <= last; ++next) {
+            cumulative += snapshot[next];
+        }
+        out << name << "_bucket{le=\"" << le << "\"} " << cumulative << "\n";
+    }
+    out << name << "_bucket{le=\"+Inf\"} " << total << "\n";
+    out << name << "_sum " << sum.load(std::memory_order_relaxed) << "\n";
+    out << name << "_count " << total << "\n";
+
+    //   :  ,     le
+    out << "# HELP " << name << "_quantile " << help << " (HDR quantile estimate)\n";
+    out << "# TYPE " << name << "_quantile gauge\n";
+    for (double quantile : { 0.5, 0.9, 0.99, 0.999 }) {
+        out << name << "_quantile{quantile=\"" << quantile << "\"} " << valueAtQuantile(quantile) << "\n";
+    }
+}
+
+BonusCounter::BonusCounter(const char* name, const char* help) : name(name), help(help) {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void BonusCounter::write(std::ostream& out) const {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " counter\n";
+    for (const auto& effect : BonusRegistry::getInstance().getEffects()) {
+        std::size_t index = static_cast<std::size_t>(effect.type);
+        if (index < counts.size()) {
+            out << name << "{type=\"" << effect.name << "\"} " << counts[index].load(std::memory_order_relaxed) << "\n";
+        }
+    }
+}
+
+Metrics& Metrics::getInstance() {
+    static Metrics instance;
+    return instance;
+}
+
+Metrics::Metrics()
+    : cascadeDepth("gems_cascade_depth", "Match removal rounds per move", 5),
+    clustersPerMove("gems_clusters_per_move", "Matched clusters per move", 6),
+    cellsClearedPerMove("gems_cells_cleared_per_move", "Cells cleared per move", 8),
+    moveLatencyNs("gems_move_latency_ns", "Wall time of move resolution, swap through final gravity, ns", 34),
+    bonusSpawned("gems_bonus_spawned_total", "Bonuses spawned"),
+    bonusActivated("gems_bonus_activated_total", "Bonuses activated")
+{
+}
+
+void Metrics::recordMove(int depth, int clusters, int cellsCleared, std::uint64_t latencyNs) {
+    cascadeDepth.record(static_cast<std::uint64_t>(depth));
+    clustersPerMove.record(static_cast<std::uint64_t>(clusters));
+    cellsClearedPerMove.record(static_cast<std::uint64_t>(cellsCleared));
+    moveLatencyNs.record(latencyNs);
+}
+
+void Metrics::writePrometheus(std::ostream& out) const {
+    cascadeDepth.write(out);
+    clustersPerMove.write(out);
+    cellsClearedPerMove.write(out);
+    moveLatencyNs.write(out);
+    bonusSpawned.write(out);
+    bonusActivated.write(out);
+}
+
+bool Metrics::writePrometheusFile(const std::string& filename) const {
+    //      ,      
+    std::string tmpName = filename + ".tmp";
+    {
+        std::ofstream file(tmpName);
+        if (!file) {
+            std::cerr << "   : " << tmpName << "\n";
+            return false;
+        }
+        writePrometheus(file);
+    }
+    //  :    ,   ,    
+#if defined(_WIN32)
+    // std::rename  Windows    
+    return MoveFileExA(tmpName.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(tmpName.c_str(), filename.c_str()) == 0;
+#endif
+}
+
+void MetricsExporter::start(const std::string& filename, float intervalSeconds) {
+    stop();
+    running = true;
+    worker = std::thread([this, filename, intervalSeconds]() {
+        auto interval = std::chrono::duration<float>(intervalSeconds);
+        std::unique_lock<std::mutex> lock(mutex);
+        while (running) {
+            wakeUp.wait_for(lock, interval, [this]() { return !running; });
+            //      
+            lock.unlock();
+            Metrics::getInstance().writePrometheusFile(filename);
+            lock.lock();
+        }
+    });
+}
+
+void MetricsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    wakeUp.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
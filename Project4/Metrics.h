@@ -0,0 +1,149 @@
+// Metrics.h
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include "Constants.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//    HDR: 16      
+// (    6.25%).    ( )  relaxed
+// load/store  RMW-,     .
+class Histogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_VALUE_BITS = 48;
+    static const int BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    Histogram(const char* name, const char* help, int exportMaxBits);
+
+    void record(std::uint64_t value) {
+        auto& count = counts[bucketIndex(value)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    //    (0..1)   
+    std::uint64_t valueAtQuantile(double quantile) const;
+
+    //     Prometheus
+    void write(std::ostream& out) const;
+
+    static int bucketIndex(std::uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<int>(value);
+        }
+        if (value >= (std::uint64_t(1) << MAX_VALUE_BITS)) {
+            return BUCKET_COUNT - 1;
+        }
+        int msb = highestBit(value);
+        int shift = msb - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<int>(value >> shift) - SUB_BUCKETS;
+    }
+
+    //     (value > 0)
+    static int highestBit(std::uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#elif defined(__GNUC__)
+        return 63 - __builtin_clzll(value);
+#else
+        int msb = 0;
+        for (int step = 32; step > 0; step >>= 1) {
+            if (value >> (msb + step)) {
+                msb += step;
+            }
+        }
+        return msb;
+#endif
+    }
+
+    //  ,    index
+    static std::uint64_t bucketUpperBound(int index);
+
+private:
+    const char* name;
+    const char* help;
+    int exportMaxBits; //  le      2^exportMaxBits
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> counts;
+    std::atomic<std::uint64_t> sum;
+};
+
+//     (  ,   Histogram)
+class BonusCounter {
+public:
+    BonusCounter(const char* name, const char* help);
+
+    void increment(BonusType type) {
+        std::size_t index = static_cast<std::size_t>(type);
+        if (index < counts.size()) {
+            counts[index].store(counts[index].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    void write(std::ostream& out) const;
+
+private:
+    const char* name;
+    const char* help;
+    std::array<std::atomic<std::uint64_t>, MAX_BONUS_TYPES> counts;
+};
+
+//   (Singleton)
+class Metrics {
+public:
+    static Metrics& getInstance();
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    //    (   )
+    void recordMove(int cascadeDepth, int clusters, int cellsCleared, std::uint64_t latencyNs);
+
+    void writePrometheus(std::ostream& out) const;
+    bool writePrometheusFile(const std::string& filename) const;
+
+    Histogram cascadeDepth;
+    Histogram clustersPerMove;
+    Histogram cellsClearedPerMove;
+    Histogram moveLatencyNs;
+    BonusCounter bonusSpawned;
+    BonusCounter bonusActivated;
+
+private:
+    Metrics();
+};
+
+//        
+class MetricsExporter {
+public:
+    MetricsExporter() : running(false) {}
+    ~MetricsExporter() { stop(); }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    void start(const std::string& filename, float intervalSeconds);
+    void stop();
+
+private:
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool running;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,229 @@
+// MoveEvaluator.cpp
+#include "MoveEvaluator.h"
+#include "BonusEffects.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <random>
+#include <thread>
+
+namespace {
+    const int dr[] = { -1, 1, 0, 0 };
+    const int dc[] = { 0, 0, -1, 1 };
+
+    //     3+ ,   (row, col)
+    bool matchesAt(const SearchBoard& board, int row, int col) {
+        int color = board.at(row, col).color;
+        if (color < 0) {
+            return false;
+        }
+        std::pair<int, int> stack[4];
+        std::pair<int, int> seen[3] = { { row, col } };
+        int seenCount = 1;
+        int top = 0;
+        stack[top++] = { row, col };
+        while (top > 0) {
+            auto [r, c] = stack[--top];
+            for (int dir = 0; dir < 4; ++dir) {
+                int nr = r + dr[dir];
+                int nc = c + dc[dir];
+                if (nr < 0 || nr >= ROWS || nc < 0 || nc >= COLS || board.at(nr, nc).color != color) {
+                    continue;
+                }
+                if (std::find(seen, seen + seenCount, std::make_pair(nr, nc)) != seen + seenCount) {
+                    continue;
+                }
+                seen[seenCount++] = { nr, nc };
+                if (seenCount >= 3) {
+                    return true;
+                }
+                stack[top++] = { nr, nc };
+            }
+        }
+        return false;
+    }
+
+    //     :   ,     
+    class SearchBonusBoard : public BonusBoard {
+    public:
+        explicit SearchBonusBoard(SearchBoard& board) : board(board) {}
+
+        CellState cellAt(int row, int col) const override { return board.at(row, col); }
+        void clearCell(int row, int col) override { board.clear(row, col); }
+        void recolorCell(int row, int col, int color) override { board.set(row, col, { color, board.at(row, col).bonus }); }
+        void clearBonus(int row, int col) override { board.set(row, col, { board.at(row, col).color, BonusType::None }); }
+
+    private:
+        SearchBoard& board;
+    };
+}
+
+MoveEvaluator::MoveEvaluator(TranspositionTable& table, int depth, int threads)
+    : table(table), depth(std::max(1, depth)), threads(std::max(1, threads)) {}
+
+MoveChoice MoveEvaluator::findBest(const BoardSnapshot& snapshot) {
+    SearchBoard root(snapshot);
+    std::vector<MoveChoice> moves;
+    generateMoves(root, moves);
+
+    //    ;     
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < moves.size(); i = next.fetch_add(1)) {
+            SearchBoard child = root;
+            int gained = applyMove(child, moves[i]);
+            moves[i].value = gained < 0 ? -1 : gained + search(child, depth - 1);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    MoveChoice best{ MoveChoice::Kind::None, -1, -1, -1, -1, -1 };
+    for (const auto& move : moves) {
+        if (move.value > best.value) {
+            best = move;
+        }
+    }
+    return best;
+}
+
+int MoveEvaluator::search(const SearchBoard& board, int remaining) {
+    if (remaining <= 0) {
+        return 0;
+    }
+
+    int cached = 0;
+    if (table.probe(board.getHash(), remaining, cached)) {
+        return cached;
+    }
+
+    std::vector<MoveChoice> moves;
+    generateMoves(board, moves);
+    int best = 0;
+    for (const auto& move : moves) {
+        SearchBoard child = board;
+        int gained = applyMove(child, move);
+        if (gained < 0) {
+            continue;
+        }
+        best = std::max(best, gained + search(child, remaining - 1));
+    }
+
+    table.store(board.getHash(), remaining, best);
+    return best;
+}
+
+void MoveEvaluator::generateMoves(const SearchBoard& board, std::vector<MoveChoice>& out) {
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            const CellState& cell = board.at(row, col);
+            if (cell.color < 0) {
+                continue;
+            }
+            if (cell.bonus != BonusType::None) {
+                out.push_back({ MoveChoice::Kind::Bonus, row, col, row, col, 0 });
+            }
+            //      ;    
+            if (col + 1 < COLS && board.at(row, col + 1).color >= 0 && board.at(row, col + 1) != cell) {
+                out.push_back({ MoveChoice::Kind::Swap, row, col, row, col + 1, 0 });
+            }
+            if (row + 1 < ROWS && board.at(row + 1, col).color >= 0 && board.at(row + 1, col) != cell) {
+                out.push_back({ MoveChoice::Kind::Swap, row, col, row + 1, col, 0 });
+            }
+        }
+    }
+}
+
+int MoveEvaluator::applyMove(SearchBoard& board, const MoveChoice& move) {
+    if (move.kind == MoveChoice::Kind::Swap) {
+        board.swap(move.row, move.col, move.otherRow, move.otherCol);
+        if (!matchesAt(board, move.row, move.col) && !matchesAt(board, move.otherRow, move.otherCol)) {
+            return -1;
+        }
+        return resolve(board);
+    }
+
+    if (move.kind == MoveChoice::Kind::Bonus) {
+        const BonusEffect* effect = BonusRegistry::getInstance().find(board.at(move.row, move.col).bonus);
+        if (effect == nullptr) {
+            return -1;
+        }
+
+        //         
+        std::mt19937 rng(static_cast<unsigned int>(board.getHash() ^ (board.getHash() >> 32)));
+        SearchBonusBoard view(board);
+        CellMask mask;
+        effect->kernel(view, move.row, move.col, rng, mask);
+        int gained = applyBonusEffect(*effect, view, mask, move.row, move.col);
+        return gained + resolve(board);
+    }
+
+    return -1;
+}
+
+int MoveEvaluator::resolve(SearchBoard& board) {
+    int gained = 0;
+    std::vector<std::pair<int, int>> cluster;
+    std::vector<std::pair<int, int>> toClear;
+
+    for (;;) {
+        //   Game::resolveCascades,   :   
+        //  ,     .
+        //  :    () 
+        for (int col = 0; col < COLS; ++col) {
+            int empty = ROWS - 1;
+            for (int row = ROWS - 1; row >= 0; --row) {
+                if (board.at(row, col).color >= 0) {
+                    if (row != empty) {
+                        board.move(row, empty, col);
+                    }
+                    --empty;
+                }
+            }
+        }
+
+        //     Game::checkMatches
+        std::array<bool, ROWS * COLS> visited{};
+        toClear.clear();
+        for (int row = 0; row < ROWS; ++row) {
+            for (int col = 0; col < COLS; ++col) {
+                int color = board.at(row, col).color;
+                if (visited[row * COLS + col] || color < 0) {
+                    continue;
+                }
+                cluster.clear();
+                cluster.emplace_back(row, col);
+                visited[row * COLS + col] = true;
+                for (std::size_t i = 0; i < cluster.size(); ++i) {
+                    auto [r, c] = cluster[i];
+                    for (int dir = 0; dir < 4; ++dir) {
+                        int nr = r + dr[dir];
+                        int nc = c + dc[dir];
+                        if (nr >= 0 && nr < ROWS && nc >= 0 && nc < COLS && !visited[nr * COLS + nc] && board.at(nr, nc).color == color) {
+                            visited[nr * COLS + nc] = true;
+                            cluster.emplace_back(nr, nc);
+                        }
+                    }
+                }
+                if (cluster.size() >= 3) {
+                    toClear.insert(toClear.end(), cluster.begin(), cluster.end());
+                }
+            }
+        }
+        if (toClear.empty()) {
+            return gained;
+        }
+
+        for (auto& [row, col] : toClear) {
+            board.clear(row, col);
+            gained += 10;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+// MoveEvaluator.h
+#ifndef MOVEEVALUATOR_H
+#define MOVEEVALUATOR_H
+
+#include <vector>
+#include "BoardHistory.h"
+#include "TranspositionTable.h"
+#include "Zobrist.h"
+
+// :       
+struct MoveChoice {
+    enum class Kind {
+        None,
+        Swap,
+        Bonus
+    };
+
+    Kind kind;
+    int row, col;
+    int otherRow, otherCol; //   
+    int value;              // :      
+};
+
+//          TranspositionTable.
+//    ,      ;
+//         ,    .
+class MoveEvaluator {
+public:
+    MoveEvaluator(TranspositionTable& table, int depth, int threads);
+
+    MoveChoice findBest(const BoardSnapshot& snapshot);
+
+    //     ; -1,     
+    static int applyMove(SearchBoard& board, const MoveChoice& move);
+
+private:
+    int search(const SearchBoard& board, int depth);
+
+    static void generateMoves(const SearchBoard& board, std::vector<MoveChoice>& out);
+    static int resolve(SearchBoard& board);
+
+    TranspositionTable& table;
+    int depth;
+    int threads;
+};
+
+#endif // MOVEEVALUATOR_H
@@ -0,0 +1,23 @@
+// MuteStdout.h
+#ifndef MUTESTDOUT_H
+#define MUTESTDOUT_H
+
+#include <iostream>
+#include <sstream>
+
+//  std::cout    : Game     ,
+//     (-, )  
+class MuteStdout {
+public:
+    MuteStdout() : saved(std::cout.rdbuf(nullStream.rdbuf())) {}
+    ~MuteStdout() { std::cout.rdbuf(saved); }
+
+    MuteStdout(const MuteStdout&) = delete;
+    MuteStdout& operator=(const MuteStdout&) = delete;
+
+private:
+    std::ostringstream nullStream;
+    std::streambuf* saved;
+};
+
+#endif // MUTESTDOUT_H
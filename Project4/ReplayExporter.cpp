@@ -0,0 +1,160 @@
+// ReplayExporter.cpp
+#include "ReplayExporter.h"
+#include "Game.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+FrameEncoder::FrameEncoder(const std::string& directory, int threads)
+    : directory(directory),
+    maxQueued(static_cast<std::size_t>(threads) * 2),
+    finishing(false),
+    failed(false)
+{
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&FrameEncoder::work, this);
+    }
+}
+
+FrameEncoder::~FrameEncoder() {
+    finish();
+}
+
+void FrameEncoder::submit(int index, sf::Image frame) {
+    std::unique_lock<std::mutex> lock(mutex);
+    hasSpace.wait(lock, [this]() { return jobs.size() < maxQueued; });
+    jobs.push_back({ index, std::move(frame) });
+    hasJob.notify_one();
+}
+
+bool FrameEncoder::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishing = true;
+    }
+    hasJob.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    return !failed;
+}
+
+void FrameEncoder::work() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hasJob.wait(lock, [this]() { return !jobs.empty() || finishing; });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        hasSpace.notify_one();
+
+        //  PNG -   ,     
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06d.png", job.index);
+        if (!job.frame.saveToFile(directory + "/" + name)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+        }
+    }
+}
+
+ReplayExporter::ReplayExporter(const Options& options) : options(options) {}
+
+bool ReplayExporter::exportSession(const Session& session) {
+    const unsigned int width = COLS * TILE_SIZE;
+    const unsigned int height = ROWS * TILE_SIZE + 50;
+
+    auto endsWith = [](const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    bool raw = endsWith(options.output, ".rgba") || endsWith(options.output, ".raw");
+
+    sf::RenderTexture target;
+    if (!target.create(width, height)) {
+        std::cerr << "     " << width << "x" << height << "\n";
+        return false;
+    }
+
+    //        , PNG  
+    std::ofstream rawFile;
+    std::unique_ptr<FrameEncoder> encoder;
+    if (raw) {
+        rawFile.open(options.output, std::ios::binary);
+        if (!rawFile) {
+            std::cerr << "   : " << options.output << "\n";
+            return false;
+        }
+    }
+    else {
+        std::error_code error;
+        std::filesystem::create_directories(options.output, error);
+        if (error) {
+            std::cerr << "   : " << options.output << "\n";
+            return false;
+        }
+        int threads = options.threads > 0 ? options.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        encoder = std::make_unique<FrameEncoder>(options.output, threads);
+    }
+
+    Game game(session.seed, true);
+    game.beginSession(session.board, session.seed);
+    //      ,   
+    game.setInstantCascades(false);
+
+    int fps = std::max(1, options.fps);
+    int framesPerInput = std::max(1, static_cast<int>(options.secondsPerInput * fps + 0.5f));
+    float frameTime = 1.0f / static_cast<float>(fps);
+    int frameIndex = 0;
+
+    auto renderFrames = [&](int count) {
+        for (int i = 0; i < count; ++i) {
+            game.update(frameTime);
+            game.draw(target);
+            target.display();
+            sf::Image frame = target.getTexture().copyToImage();
+            if (raw) {
+                rawFile.write(reinterpret_cast<const char*>(frame.getPixelsPtr()), static_cast<std::streamsize>(width) * height * 4);
+            }
+            else {
+                encoder->submit(frameIndex, std::move(frame));
+            }
+            ++frameIndex;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    renderFrames(framesPerInput);
+    for (const auto& input : session.inputs) {
+        game.applyInput(input);
+        renderFrames(framesPerInput);
+    }
+    //  ,   ,     
+    while (!game.isSettled()) {
+        renderFrames(1);
+    }
+    bool ok = raw ? static_cast<bool>(rawFile.flush()) : encoder->finish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double videoSeconds = static_cast<double>(frameIndex) / fps;
+    std::cout << "Exported " << frameIndex << " frames (" << videoSeconds << " s of video) in " << seconds << " s, "
+        << (seconds > 0 ? videoSeconds / seconds : 0.0) << "x real time\n";
+    if (raw) {
+        std::cout << "Encode with: ffmpeg -f rawvideo -pix_fmt rgba -s " << width << "x" << height
+            << " -r " << fps << " -i " << options.output << " out.mp4\n";
+    }
+    if (!ok) {
+        std::cerr << "    \n";
+    }
+    return ok;
+}
@@ -0,0 +1,68 @@
+// ReplayExporter.h
+#ifndef REPLAYEXPORTER_H
+#define REPLAYEXPORTER_H
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Session.h"
+
+//    PNG   
+class FrameEncoder {
+public:
+    FrameEncoder(const std::string& directory, int threads);
+    ~FrameEncoder();
+
+    FrameEncoder(const FrameEncoder&) = delete;
+    FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+    //    ; ,    ( )
+    void submit(int index, sf::Image frame);
+
+    //    ;  false,  -   
+    bool finish();
+
+private:
+    struct Job {
+        int index;
+        sf::Image frame;
+    };
+
+    void work();
+
+    std::string directory;
+    std::size_t maxQueued;
+    std::deque<Job> jobs;
+    std::mutex mutex;
+    std::condition_variable hasJob;
+    std::condition_variable hasSpace;
+    bool finishing;
+    bool failed;
+    std::vector<std::thread> workers;
+};
+
+//      PNG   RGBA-.
+//     Game::draw   ,   - .
+class ReplayExporter {
+public:
+    struct Options {
+        std::string output;          //   PNG   .rgba   
+        int fps = 30;
+        float secondsPerInput = 0.5f; //      
+        int threads = 0;              // 0 -   
+    };
+
+    explicit ReplayExporter(const Options& options);
+
+    bool exportSession(const Session& session);
+
+private:
+    Options options;
+};
+
+#endif // REPLAYEXPORTER_H
@@ -18,6 +18,7 @@ public:
     //     
     bool loadTexture(const std::string& name, const std::string& filename);
     sf::Texture& getTexture(const std::string& name);
+    bool hasTexture(const std::string& name) const { return textures.find(name) != textures.end(); }
 
     //      
     bool loadSoundBuffer(const std::string& name, const std::string& filename);
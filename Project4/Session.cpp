@@ -0,0 +1,73 @@
+// Session.cpp
+#include "Session.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool Session::save(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "   : " << filename << "\n";
+        return false;
+    }
+
+    file << seed << "\n";
+    for (const auto& row : board) {
+        for (int col = 0; col < COLS; ++col) {
+            file << row[col] << (col + 1 < COLS ? " " : "\n");
+        }
+    }
+    for (const auto& input : inputs) {
+        switch (input.kind) {
+        case SessionInput::Kind::Click:
+            file << input.row << " " << input.col << " " << (input.doubleClick ? 1 : 0) << "\n";
+            break;
+        case SessionInput::Kind::Undo:
+            file << "undo\n";
+            break;
+        case SessionInput::Kind::Redo:
+            file << "redo\n";
+            break;
+        }
+    }
+    return true;
+}
+
+bool Session::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file || !(file >> seed)) {
+        return false;
+    }
+    for (auto& row : board) {
+        for (int& color : row) {
+            if (!(file >> color) || color < 0 || color >= NUM_COLORS) {
+                return false;
+            }
+        }
+    }
+
+    inputs.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        if (line == "undo") {
+            inputs.push_back(SessionInput::undo());
+            continue;
+        }
+        if (line == "redo") {
+            inputs.push_back(SessionInput::redo());
+            continue;
+        }
+        std::istringstream fields(line);
+        int row = 0;
+        int col = 0;
+        int doubleClick = 0;
+        if (!(fields >> row >> col >> doubleClick) || row < 0 || row >= ROWS || col < 0 || col >= COLS) {
+            return false;
+        }
+        inputs.push_back(SessionInput::click(row, col, doubleClick != 0));
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+// Session.h
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <string>
+#include <vector>
+#include "BoardGenerator.h"
+
+//   ,    Game::applyInput
+struct SessionInput {
+    enum class Kind {
+        Click,
+        Undo,
+        Redo
+    };
+
+    Kind kind;
+    int row;
+    int col;
+    bool doubleClick;
+
+    static SessionInput click(int row, int col, bool doubleClick) { return { Kind::Click, row, col, doubleClick }; }
+    static SessionInput undo() { return { Kind::Undo, -1, -1, false }; }
+    static SessionInput redo() { return { Kind::Redo, -1, -1, false }; }
+};
+
+//  :  ,     .
+//   Game::beginSession(board, seed)     .
+struct Session {
+    unsigned int seed = 0;
+    ColorGrid board{};
+    std::vector<SessionInput> inputs;
+
+    // : seed, ROWS  ,      ("row col doubleClick", "undo", "redo")
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+};
+
+#endif // SESSION_H
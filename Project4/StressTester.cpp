@@ -0,0 +1,239 @@
+// StressTester.cpp
+#include "StressTester.h"
+#include "Game.h"
+#include "MuteStdout.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+    //       
+    void nextAction(const Game& game, std::mt19937& rng, std::vector<SessionInput>& out) {
+        const auto& grid = game.getGrid();
+
+        std::vector<std::pair<int, int>> bonuses;
+        for (int row = 0; row < ROWS; ++row) {
+            for (int col = 0; col < COLS; ++col) {
+                if (grid[row][col].bonus != BonusType::None) {
+                    bonuses.emplace_back(row, col);
+                }
+            }
+        }
+
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+        //   :      ,    
+        float historyChance = chance(rng);
+        if (historyChance < 0.1f) {
+            out.push_back(SessionInput::undo());
+            return;
+        }
+        if (historyChance < 0.15f) {
+            out.push_back(SessionInput::redo());
+            return;
+        }
+
+        if (!bonuses.empty() && chance(rng) < 0.3f) {
+            //    :  ,  
+            std::uniform_int_distribution<int> pick(0, static_cast<int>(bonuses.size()) - 1);
+            auto [row, col] = bonuses[pick(rng)];
+            out.push_back(SessionInput::click(row, col, false));
+            out.push_back(SessionInput::click(row, col, true));
+            return;
+        }
+
+        // :     
+        std::uniform_int_distribution<int> rowDist(0, ROWS - 1);
+        std::uniform_int_distribution<int> colDist(0, COLS - 1);
+        std::uniform_int_distribution<int> dirDist(0, 3);
+        const int dr[] = { -1, 1, 0, 0 };
+        const int dc[] = { 0, 0, -1, 1 };
+        int row = rowDist(rng);
+        int col = colDist(rng);
+        int dir = dirDist(rng);
+        int otherRow = row + dr[dir];
+        int otherCol = col + dc[dir];
+        if (otherRow < 0 || otherRow >= ROWS || otherCol < 0 || otherCol >= COLS) {
+            otherRow = row - dr[dir];
+            otherCol = col - dc[dir];
+        }
+        out.push_back(SessionInput::click(row, col, false));
+        out.push_back(SessionInput::click(otherRow, otherCol, false));
+    }
+
+    //  :     (, ).
+    // "unresolved matches left on board (5 cells)" -> "unresolved matches left on board"
+    std::string failureKind(const std::string& error) {
+        std::size_t end = error.find_first_of("(-0123456789");
+        std::string kind = error.substr(0, end);
+        if (kind.size() >= 4 && kind.compare(kind.size() - 4, 4, " at ") == 0) {
+            kind.resize(kind.size() - 4);
+        }
+        while (!kind.empty() && kind.back() == ' ') {
+            kind.pop_back();
+        }
+        return kind;
+    }
+
+    //    ; score   
+    bool checkStep(Game& game, int& lastScore, bool requireResolved, std::string& error) {
+        if (!game.checkInvariants(error, requireResolved)) {
+            return false;
+        }
+        if (game.getScore() < lastScore) {
+            error = "score decreased from " + std::to_string(lastScore) + " to " + std::to_string(game.getScore());
+            return false;
+        }
+        lastScore = game.getScore();
+        return true;
+    }
+}
+
+StressTester::StressTester(unsigned int seed, bool requireResolved)
+    : seed(seed), requireResolved(requireResolved), rng(seed) {}
+
+bool StressTester::run(int steps, const std::string& failureFile) {
+    Session session;
+    std::vector<SessionInput> action;
+    std::string error;
+    bool failed = false;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        MuteStdout mute;
+        Game game(seed, true);
+        session = game.getSession(); //    
+        int lastScore = game.getScore();
+        if (!checkStep(game, lastScore, requireResolved, error)) {
+            failed = true;
+        }
+
+        for (int step = 0; step < steps && !failed; ++step) {
+            action.clear();
+            nextAction(game, rng, action);
+            for (const auto& input : action) {
+                session.inputs.push_back(input);
+                game.applyInput(input);
+                // Undo  redo   
+                if (input.kind != SessionInput::Kind::Click) {
+                    lastScore = game.getScore();
+                }
+                if (!checkStep(game, lastScore, requireResolved, error)) {
+                    failed = true;
+                    break;
+                }
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Stress seed " << seed << ": " << session.inputs.size() << " inputs in " << seconds << " s ("
+        << static_cast<long long>(seconds > 0 ? session.inputs.size() / seconds : 0) << " inputs/s)\n";
+
+    if (!failed) {
+        std::cout << "All invariants held.\n";
+        return true;
+    }
+
+    std::cout << "Invariant violated after input " << session.inputs.size() << ": " << error << "\n";
+    Session minimal = minimize(session);
+    Outcome outcome = execute(minimal, requireResolved);
+    std::cout << "Minimized to " << minimal.inputs.size() << " inputs: " << outcome.error << "\n";
+    if (minimal.save(failureFile)) {
+        std::cout << "Reproduce with: --replay " << failureFile << "\n";
+    }
+    return false;
+}
+
+Session StressTester::generate(int steps) {
+    MuteStdout mute;
+    Game game(seed, true);
+    Session session = game.getSession();
+    std::vector<SessionInput> action;
+    for (int step = 0; step < steps; ++step) {
+        action.clear();
+        nextAction(game, rng, action);
+        for (const auto& input : action) {
+            session.inputs.push_back(input);
+            game.applyInput(input);
+        }
+    }
+    return session;
+}
+
+bool StressTester::replay(const std::string& filename, bool requireResolved) {
+    Session session;
+    if (!session.load(filename)) {
+        std::cerr << "    : " << filename << "\n";
+        return false;
+    }
+
+    Outcome outcome = execute(session, requireResolved);
+    if (outcome.failedStep < 0) {
+        std::cout << "Replay of " << session.inputs.size() << " inputs (seed " << session.seed << "): all invariants held.\n";
+        return true;
+    }
+    std::cout << "Replay (seed " << session.seed << ") failed at input " << outcome.failedStep << ": " << outcome.error << "\n";
+    return false;
+}
+
+StressTester::Outcome StressTester::execute(const Session& session, bool requireResolved) {
+    MuteStdout mute;
+    Outcome outcome{ -1, "" };
+    Game game(session.seed, true);
+    game.beginSession(session.board, session.seed);
+    int lastScore = game.getScore();
+    std::string error;
+
+    if (!checkStep(game, lastScore, requireResolved, error)) {
+        return { 0, error };
+    }
+    for (std::size_t i = 0; i < session.inputs.size(); ++i) {
+        game.applyInput(session.inputs[i]);
+        // Undo  redo   
+        if (session.inputs[i].kind != SessionInput::Kind::Click) {
+            lastScore = game.getScore();
+        }
+        if (!checkStep(game, lastScore, requireResolved, error)) {
+            outcome = { static_cast<int>(i) + 1, error };
+            break;
+        }
+    }
+    return outcome;
+}
+
+Session StressTester::minimize(const Session& failing) const {
+    //     
+    Outcome first = execute(failing, requireResolved);
+    if (first.failedStep < 0) {
+        return failing;
+    }
+    Session current = failing;
+    current.inputs.resize(first.failedStep);
+    std::string kind = failureKind(first.error);
+
+    //  delta debugging:  ,     .
+    //   (   MAX_MATCH_CHECKS)  ,     
+    std::size_t chunk = current.inputs.size() / 2;
+    while (chunk > 0) {
+        bool reduced = false;
+        for (std::size_t start = 0; start < current.inputs.size(); ) {
+            Session candidate = current;
+            auto from = candidate.inputs.begin() + start;
+            candidate.inputs.erase(from, from + std::min(chunk, candidate.inputs.size() - start));
+
+            Outcome outcome = execute(candidate, requireResolved);
+            if (outcome.failedStep >= 0 && failureKind(outcome.error) == kind) {
+                candidate.inputs.resize(outcome.failedStep);
+                current = candidate;
+                reduced = true;
+            }
+            else {
+                start += chunk;
+            }
+        }
+        if (!reduced) {
+            chunk /= 2;
+        }
+    }
+    return current;
+}
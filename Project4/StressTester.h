@@ -0,0 +1,40 @@
+// StressTester.h
+#ifndef STRESSTESTER_H
+#define STRESSTESTER_H
+
+#include <random>
+#include <string>
+#include <vector>
+#include "Session.h"
+
+//  -:  ,  ,      
+class StressTester {
+public:
+    // requireResolved:   ,  -  MAX_MATCH_CHECKS
+    StressTester(unsigned int seed, bool requireResolved = true);
+
+    //  steps  ;       
+    bool run(int steps, const std::string& failureFile = "stress_failure.txt");
+
+    //    steps    (  )
+    Session generate(int steps);
+
+    //    ( -   )
+    static bool replay(const std::string& filename, bool requireResolved = true);
+
+private:
+    //  :  ,     (-1,   )
+    struct Outcome {
+        int failedStep;
+        std::string error;
+    };
+
+    static Outcome execute(const Session& session, bool requireResolved);
+    Session minimize(const Session& failing) const;
+
+    unsigned int seed;
+    bool requireResolved;
+    std::mt19937 rng;
+};
+
+#endif // STRESSTESTER_H
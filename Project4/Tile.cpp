@@ -1,7 +1,7 @@
 // Tile.cpp
 #include "Tile.h"
 
-Tile::Tile() : color(0), bonus(BonusType::None), isSelected(false), isAnimating(false), animationDuration(0.5f) {
+Tile::Tile() : color(0), bonus(BonusType::None), isSelected(false), isAnimating(false), animationTime(0.0f), animationDuration(0.5f) {
     //  
     shape.setSize(sf::Vector2f(static_cast<float>(TILE_SIZE - 2), static_cast<float>(TILE_SIZE - 2)));
     shape.setOutlineThickness(1.0f);
@@ -25,21 +25,20 @@ Tile::Tile() : color(0), bonus(BonusType::None), isSelected(false), isAnimating(
     animationOverlay.setPosition(shape.getPosition());
 }
 
-//     
+//     (   ,    )
 void Tile::updateFuse(float deltaTime) {
-    if (bonus == BonusType::Bomb) {
-        //     ()
-        float time = animationClock.getElapsedTime().asSeconds();
-        float scale = 1.0f + 0.3f * std::sin(time * 5.0f);
-        fuse.setScale(scale, scale);
-        //    
-        sf::Color currentColor = fuse.getFillColor();
-        currentColor.a = static_cast<sf::Uint8>(128 + 127 * std::sin(time * 5.0f));
-        fuse.setFillColor(currentColor);
-    }
+    //     ()
+    animationTime += deltaTime;
+    float time = animationTime;
+    float scale = 1.0f + 0.3f * std::sin(time * 5.0f);
+    fuse.setScale(scale, scale);
+    //    
+    sf::Color currentColor = fuse.getFillColor();
+    currentColor.a = static_cast<sf::Uint8>(128 + 127 * std::sin(time * 5.0f));
+    fuse.setFillColor(currentColor);
 }
 
-//     
+//    
 void Tile::resetFuse() {
     fuse.setPosition(-10, -10);
     fuse.setScale(1.0f, 1.0f);
@@ -9,14 +9,14 @@ struct Tile {
     int color;
     sf::RectangleShape shape;
     BonusType bonus;
-    sf::CircleShape fuse; //  
-    sf::Sprite recolorIcon; //  
+    sf::CircleShape fuse; //  (   showFuse)
+    sf::Sprite bonusIcon; //  
     sf::RectangleShape highlight; //   
     bool isSelected;
 
     // 
     bool isAnimating;
-    sf::Clock animationClock;
+    float animationTime; //   deltaTime,       
     float animationDuration;
     sf::RectangleShape animationOverlay; //   
 
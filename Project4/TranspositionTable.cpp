@@ -0,0 +1,55 @@
+// TranspositionTable.cpp
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(std::size_t entryCount) : probes(0), hits(0), stores(0) {
+    std::size_t size = 1;
+    while (size < entryCount) {
+        size <<= 1;
+    }
+    entries.reset(new Entry[size]);
+    mask = size - 1;
+    clear();
+}
+
+bool TranspositionTable::probe(std::uint64_t key, int depth, int& value) {
+    probes.fetch_add(1, std::memory_order_relaxed);
+    Entry& entry = entries[key & mask];
+    std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+    std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+
+    //    depth = 0,      depth >= 1
+    int storedDepth = static_cast<int>(data >> 32);
+    if ((check ^ data) != key || storedDepth < depth || storedDepth == 0) {
+        return false;
+    }
+    value = static_cast<std::int32_t>(static_cast<std::uint32_t>(data));
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void TranspositionTable::store(std::uint64_t key, int depth, int value) {
+    stores.fetch_add(1, std::memory_order_relaxed);
+    Entry& entry = entries[key & mask];
+    std::uint64_t data = static_cast<std::uint64_t>(static_cast<std::uint32_t>(value))
+        | (static_cast<std::uint64_t>(depth) << 32);
+    //  :        
+    entry.check.store(key ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (std::size_t i = 0; i <= mask; ++i) {
+        entries[i].check.store(0, std::memory_order_relaxed);
+        entries[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+TranspositionTable::Stats TranspositionTable::getStats() const {
+    return { probes.load(std::memory_order_relaxed), hits.load(std::memory_order_relaxed), stores.load(std::memory_order_relaxed) };
+}
+
+void TranspositionTable::resetStats() {
+    probes.store(0, std::memory_order_relaxed);
+    hits.store(0, std::memory_order_relaxed);
+    stores.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,47 @@
+// TranspositionTable.h
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//      .
+//  :   -    (key ^ data, data), 
+//         .
+class TranspositionTable {
+public:
+    //      
+    explicit TranspositionTable(std::size_t entryCount);
+
+    //   ,      depth
+    bool probe(std::uint64_t key, int depth, int& value);
+    void store(std::uint64_t key, int depth, int value);
+    void clear();
+
+    struct Stats {
+        std::uint64_t probes;
+        std::uint64_t hits;
+        std::uint64_t stores;
+
+        double hitRate() const { return probes > 0 ? static_cast<double>(hits) / static_cast<double>(probes) : 0.0; }
+    };
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    struct Entry {
+        std::atomic<std::uint64_t> check; // key ^ data
+        std::atomic<std::uint64_t> data;  // value (32 ) | depth << 32
+    };
+
+    std::unique_ptr<Entry[]> entries;
+    std::size_t mask;
+
+    std::atomic<std::uint64_t> probes;
+    std::atomic<std::uint64_t> hits;
+    std::atomic<std::uint64_t> stores;
+};
+
+#endif // TRANSPOSITIONTABLE_H
@@ -0,0 +1,46 @@
+// Zobrist.cpp
+#include "Zobrist.h"
+#include <random>
+
+const ZobristKeys& ZobristKeys::getInstance() {
+    static ZobristKeys instance;
+    return instance;
+}
+
+ZobristKeys::ZobristKeys() {
+    //  :    
+    std::mt19937_64 rng(0x5EED2024u);
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            //   ( -1)      
+            colorKeys[row][col][0] = 0;
+            for (int color = 1; color <= NUM_COLORS; ++color) {
+                colorKeys[row][col][color] = rng();
+            }
+            bonusKeys[row][col][0] = 0;
+            for (int bonus = 1; bonus < MAX_BONUS_TYPES; ++bonus) {
+                bonusKeys[row][col][bonus] = rng();
+            }
+        }
+    }
+}
+
+SearchBoard::SearchBoard(const BoardSnapshot& snapshot) {
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            cells[row * COLS + col] = snapshot.at(row, col);
+        }
+    }
+    hash = computeHash();
+}
+
+std::uint64_t SearchBoard::computeHash() const {
+    const ZobristKeys& keys = ZobristKeys::getInstance();
+    std::uint64_t value = 0;
+    for (int row = 0; row < ROWS; ++row) {
+        for (int col = 0; col < COLS; ++col) {
+            value ^= keys.cellKey(row, col, at(row, col));
+        }
+    }
+    return value;
+}
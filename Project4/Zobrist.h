@@ -0,0 +1,70 @@
+// Zobrist.h
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+#include "Constants.h"
+#include "BoardHistory.h"
+
+//   Zobrist       (Singleton)
+class ZobristKeys {
+public:
+    static const ZobristKeys& getInstance();
+
+    ZobristKeys(const ZobristKeys&) = delete;
+    ZobristKeys& operator=(const ZobristKeys&) = delete;
+
+    //    ;      0
+    std::uint64_t cellKey(int row, int col, const CellState& cell) const {
+        return colorKeys[row][col][cell.color + 1] ^ bonusKeys[row][col][static_cast<int>(cell.bonus)];
+    }
+
+private:
+    ZobristKeys();
+
+    std::array<std::array<std::array<std::uint64_t, NUM_COLORS + 1>, COLS>, ROWS> colorKeys;
+    std::array<std::array<std::array<std::uint64_t, MAX_BONUS_TYPES>, COLS>, ROWS> bonusKeys;
+};
+
+//      ,    O(1)   
+class SearchBoard {
+public:
+    explicit SearchBoard(const BoardSnapshot& snapshot);
+
+    const CellState& at(int row, int col) const { return cells[row * COLS + col]; }
+
+    void set(int row, int col, const CellState& cell) {
+        const ZobristKeys& keys = ZobristKeys::getInstance();
+        CellState& current = cells[row * COLS + col];
+        hash ^= keys.cellKey(row, col, current) ^ keys.cellKey(row, col, cell);
+        current = cell;
+    }
+
+    //   
+    void swap(int firstRow, int firstCol, int secondRow, int secondCol) {
+        CellState first = at(firstRow, firstCol);
+        set(firstRow, firstCol, at(secondRow, secondCol));
+        set(secondRow, secondCol, first);
+    }
+
+    //  
+    void clear(int row, int col) { set(row, col, { -1, BonusType::None }); }
+
+    //    : fromRow 
+    void move(int fromRow, int toRow, int col) {
+        set(toRow, col, at(fromRow, col));
+        clear(fromRow, col);
+    }
+
+    std::uint64_t getHash() const { return hash; }
+
+    //    (  )
+    std::uint64_t computeHash() const;
+
+private:
+    std::array<CellState, ROWS * COLS> cells;
+    std::uint64_t hash;
+};
+
+#endif // ZOBRIST_H
@@ -1,7 +1,189 @@
 // main.cpp
+#include "Benchmark.h"
 #include "Game.h"
+#include "LiveState.h"
+#include "StressTester.h"
+#include "ReplayExporter.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    //    :    2,     
+    int usage(const char* text) {
+        std::cerr << ": " << text << "\n";
+        return 2;
+    }
+
+    //    : "12abc",       - 
+    bool parseInt(const std::string& text, int minValue, int& value) {
+        try {
+            std::size_t used = 0;
+            long long parsed = std::stoll(text, &used);
+            if (used != text.size() || parsed < minValue || parsed > std::numeric_limits<int>::max()) {
+                return false;
+            }
+            value = static_cast<int>(parsed);
+            return true;
+        }
+        catch (const std::logic_error&) {
+            return false;
+        }
+    }
+
+    bool parseSeed(const std::string& text, unsigned int& value) {
+        try {
+            std::size_t used = 0;
+            // std::stoull   "-1"   
+            unsigned long long parsed = std::stoull(text, &used);
+            if (used != text.size() || text.find('-') != std::string::npos || parsed > std::numeric_limits<unsigned int>::max()) {
+                return false;
+            }
+            value = static_cast<unsigned int>(parsed);
+            return true;
+        }
+        catch (const std::logic_error&) {
+            return false;
+        }
+    }
+
+    bool parseFraction(const std::string& text, double& value) {
+        try {
+            std::size_t used = 0;
+            double parsed = std::stod(text, &used);
+            if (used != text.size() || !(parsed >= 0.0)) {
+                return false;
+            }
+            value = parsed;
+            return true;
+        }
+        catch (const std::logic_error&) {
+            return false;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+
+    //     ;    
+    bool requireResolved = true;
+    std::vector<std::string> args;
+    for (int i = 2; i < argc; ++i) {
+        if (std::string(argv[i]) == "--allow-unresolved") {
+            requireResolved = false;
+        }
+        else {
+            args.push_back(argv[i]);
+        }
+    }
+
+    //  -: --stress [seed] [steps] [--allow-unresolved]
+    if (mode == "--stress") {
+        unsigned int seed = std::random_device{}();
+        int steps = 10000;
+        if ((args.size() > 0 && !parseSeed(args[0], seed)) || (args.size() > 1 && !parseInt(args[1], 0, steps))) {
+            return usage("--stress [seed] [steps] [--allow-unresolved]");
+        }
+        StressTester tester(seed, requireResolved);
+        return tester.run(steps) ? 0 : 1;
+    }
+
+    //   : --replay <file> [--allow-unresolved]
+    if (mode == "--replay") {
+        if (args.empty()) {
+            return usage("--replay <file> [--allow-unresolved]");
+        }
+        return StressTester::replay(args[0], requireResolved) ? 0 : 1;
+    }
+
+    //    : --export <session> < | .rgba> [fps]
+    if (mode == "--export") {
+        if (args.size() < 2) {
+            return usage("--export <session> < | .rgba> [fps]");
+        }
+        ReplayExporter::Options options;
+        options.output = args[1];
+        if (args.size() > 2 && !parseInt(args[2], 1, options.fps)) {
+            return usage("--export <session> < | .rgba> [fps]");
+        }
+        Session session;
+        if (!session.load(args[0])) {
+            std::cerr << "   : " << args[0] << "\n";
+            return 1;
+        }
+        return ReplayExporter(options).exportSession(session) ? 0 : 1;
+    }
+
+    //    : --bench [corpus] [--update-baseline] [--tolerance X]
+    if (mode == "--bench") {
+        Benchmark::Options options;
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            if (args[i] == "--update-baseline") {
+                options.updateBaseline = true;
+            }
+            else if (args[i] == "--tolerance") {
+                if (i + 1 >= args.size() || !parseFraction(args[++i], options.tolerance)) {
+                    return usage("--bench [corpus] [--update-baseline] [--tolerance X]");
+                }
+            }
+            else {
+                options.corpus = args[i];
+                options.baseline = args[i] + "/baseline.txt";
+            }
+        }
+        return Benchmark(options).run();
+    }
+
+    //    : --bench-record [corpus] [count] [steps]
+    if (mode == "--bench-record") {
+        std::string directory = args.size() > 0 ? args[0] : "benchmarks";
+        int count = 8;
+        int steps = 200;
+        if ((args.size() > 1 && !parseInt(args[1], 1, count)) || (args.size() > 2 && !parseInt(args[2], 1, steps))) {
+            return usage("--bench-record [corpus] [count] [steps]");
+        }
+        return Benchmark::recordCorpus(directory, count, steps) ? 0 : 1;
+    }
+
+    //     : --dump-live [interval_ms] [count]
+    //     , count = 0 -   
+    if (mode == "--dump-live") {
+        int intervalMs = 0;
+        if (args.size() > 0 && !parseInt(args[0], 0, intervalMs)) {
+            return usage("--dump-live [interval_ms] [count]");
+        }
+        int count = intervalMs > 0 ? 0 : 1;
+        if (args.size() > 1 && !parseInt(args[1], 0, count)) {
+            return usage("--dump-live [interval_ms] [count]");
+        }
+        LiveStateReader reader;
+        if (!reader.open()) {
+            std::cerr << "  :    (" << LIVE_STATE_NAME << ")\n";
+            return 1;
+        }
+        std::uint64_t lastFrame = 0;
+        for (int printed = 0; count == 0 || printed < count;) {
+            LiveStateData data;
+            if (reader.read(data) && data.frame != lastFrame) {
+                writeLiveState(std::cout, data);
+                std::cout << std::endl;
+                lastFrame = data.frame;
+                ++printed;
+                if (count != 0 && printed >= count) {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::max(1, intervalMs)));
+        }
+        return 0;
+    }
 
-int main() {
     Game game;
     game.run();
     return 0;